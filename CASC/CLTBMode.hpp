@@ -109,6 +109,8 @@ private:
    * problem that should be attempted. */
   StringPairStack _problemFiles;
 
+  /** SInE selection structure for the theory axioms of the batch */
+  ScopedPtr<Shell::SineTheorySelector> _theorySelector;
   ScopedPtr<Problem> _baseProblem;
 
   // This contains formulas 'learned' in the sense that they were input
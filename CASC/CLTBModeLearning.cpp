@@ -29,6 +29,7 @@
 
 #include "Lib/Portability.hpp"
 
+#include "Lib/DArray.hpp"
 #include "Lib/DHSet.hpp"
 #include "Lib/Environment.hpp"
 #include "Lib/Exception.hpp"
@@ -40,11 +41,13 @@
 #include "Lib/ScopedPtr.hpp"
 #include "Lib/Sort.hpp"
 
+#include "Lib/Sys/MappedFile.hpp"
 #include "Lib/Sys/Multiprocessing.hpp"
 #include "Lib/Sys/SyncPipe.hpp"
 
 #include "Shell/Options.hpp"
 #include "Shell/Normalisation.hpp"
+#include "Shell/ProblemCache.hpp"
 #include "Saturation/ProvingHelper.hpp"
 #include "Shell/Statistics.hpp"
 #include "Shell/UIHelper.hpp"
@@ -284,18 +287,41 @@ void CLTBModeLearning::loadIncludes()
     TimeCounter tc(TC_PARSING);
     env.statistics->phase=Statistics::PARSING;
 
+    // axiom files can be huge, so they are parsed directly from memory;
+    // all of them are mapped first so that the system reads them in the
+    // background while the first ones are being parsed
+    unsigned includeCnt=StringList::length(_theoryIncludes);
+    DArray<vstring> fnames(includeCnt);
+    DArray<ScopedPtr<Lib::Sys::MappedFile> > files(includeCnt);
     StringList::Iterator iit(_theoryIncludes);
-    while (iit.hasNext()) {
-      vstring fname=env.options->includeFileName(iit.next());
+    for (unsigned i=0;i<includeCnt;i++) {
+      fnames[i]=env.options->includeFileName(iit.next());
+      files[i]=new Lib::Sys::MappedFile(fnames[i]);
+      if (!files[i]->isOpen()) {
+        USER_ERROR("Cannot open included file: "+fnames[i]);
+      }
+      files[i]->prefetch();
+    }
 
-      ifstream inp(fname.c_str());
-      if (inp.fail()) {
-        USER_ERROR("Cannot open included file: "+fname);
+    for (unsigned i=0;i<includeCnt;i++) {
+      vstring fname=fnames[i];
+      ScopedPtr<Lib::Sys::MappedFile> inp(files[i].release());
+      UnitList* funits;
+      bool containsConjecture;
+      ScopedPtr<ProblemCache> cache;
+      if (env.options->problemCache()!="") {
+        cache = new ProblemCache(env.options->problemCache(),fname);
       }
-      Parse::TPTP parser(inp);
-      parser.parse();
-      UnitList* funits = parser.units();
-      if (parser.containsConjecture()) {
+      if (!cache || !cache->load(funits,containsConjecture)) {
+        Parse::TPTP parser(inp->data(),inp->size());
+        parser.parse();
+        funits = parser.units();
+        containsConjecture = parser.containsConjecture();
+        if (cache) {
+          cache->store(parser);
+        }
+      }
+      if (containsConjecture) {
 	USER_ERROR("Axiom file " + fname + " contains a conjecture.");
       }
 
@@ -308,6 +334,11 @@ void CLTBModeLearning::loadIncludes()
   }
 
   _baseProblem = new Problem(theoryAxioms);
+  //the theory axioms are indexed for SInE once for the whole batch, the
+  //slices then only run the selection for their problem
+  _theorySelector = new SineTheorySelector();
+  _theorySelector->initSelectionStructure(theoryAxioms);
+  _baseProblem->setSineTheorySelector(_theorySelector.ptr());
   //ensure we scan the theory axioms for property here, so we don't need to
   //do it afterward in each problem
   _baseProblem->getProperty();
@@ -1116,18 +1147,6 @@ void CLTBProblemLearning::runSlice(Options& strategyOpt, bool printProof)
   opt.setProblemName(problemFile);
   *env.options = opt; //just temporarily until we get rid of dependencies on env.options in solving
 
-//  if (env.options->sineSelection()!=Options::SS_OFF) {
-//    //add selected axioms from the theory
-//    parent->theorySelector.perform(probUnits);
-//
-//    env.options->setSineSelection(Options::SS_OFF);
-//    env.options->forceIncompleteness();
-//  }
-//  else {
-//    //if there wasn't any sine selection, just put in all theory axioms
-//    probUnits=UnitList::concat(probUnits, parent->theoryAxioms);
-//  }
-
   env.beginOutput();
   CLTBModeLearning::lineOutput() << opt.testId() << " on " << opt.problemName() << endl;
   env.endOutput();
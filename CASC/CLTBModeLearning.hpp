@@ -97,6 +97,8 @@ private:
    * problem that should be attempted. */
   StringPairStack _problemFiles;
 
+  /** SInE selection structure for the theory axioms of the batch */
+  ScopedPtr<Shell::SineTheorySelector> _theorySelector;
   ScopedPtr<Problem> _baseProblem;
 
   Semaphore stratSem;
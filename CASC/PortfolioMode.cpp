@@ -21,6 +21,7 @@
  * Implements class PortfolioMode.
  */
 
+#include "Lib/DHMap.hpp"
 #include "Lib/Environment.hpp"
 #include "Lib/Int.hpp"
 #include "Lib/Portability.hpp"
@@ -30,8 +31,10 @@
 #include "Lib/TimeCounter.hpp"
 #include "Lib/Timer.hpp"
 #include "Lib/Sys/Multiprocessing.hpp"
+#include "Lib/Sys/ProgressBoard.hpp"
 
 #include "Shell/Options.hpp"
+#include "Shell/Preprocess.hpp"
 #include "Shell/Statistics.hpp"
 #include "Shell/UIHelper.hpp"
 #include "Shell/Normalisation.hpp"
@@ -39,6 +42,7 @@
 
 #include <unistd.h>
 
+#include "Saturation/ClauseSharing.hpp"
 #include "Saturation/ProvingHelper.hpp"
 
 #include "Kernel/Problem.hpp"
@@ -50,7 +54,7 @@
 using namespace Lib;
 using namespace CASC;
 
-PortfolioMode::PortfolioMode() : _slowness(1.0), _syncSemaphore(2) {
+PortfolioMode::PortfolioMode() : _slowness(1.0), _prbPreprocessed(false), _groupWorkers(1), _syncSemaphore(2) {
   // We need the following two values because the way the semaphore class is currently implemented:
   // 1) dec is the only operation which is blocking
   // 2) dec is done in the mode SEM_UNDO, so is undone when a process terminates
@@ -280,6 +284,63 @@ float PortfolioProcessPriorityPolicy::dynamicPriority(pid_t pid)
   return 0.;
 }
 
+/**
+ * Number of deciseconds a slice may go without activating any clause
+ * before we consider it stuck
+ */
+#define STAGNATION_TIME 30
+
+PortfolioDynamicPriorityPolicy::PortfolioDynamicPriorityPolicy(Sys::ProgressBoard* board)
+  : _board(board)
+{
+  ASS(board);
+}
+
+unsigned PortfolioDynamicPriorityPolicy::watchInterval()
+{
+  return 1;
+}
+
+/**
+ * Return true if the slice @b pid is about to run out of memory, or if
+ * it did not activate any clause for STAGNATION_TIME deciseconds, which
+ * happens when it gets stuck in simplifications or in a SAT solver call.
+ */
+bool PortfolioDynamicPriorityPolicy::shouldTerminate(pid_t pid)
+{
+  CALL("PortfolioDynamicPriorityPolicy::shouldTerminate");
+
+  Sys::ProgressBoard::Entry e;
+  if (!_board->get(pid,e)) {
+    // not saturating yet
+    return false;
+  }
+
+  size_t memoryLimit = Allocator::getMemoryLimit();
+  if (memoryLimit && e.memory > memoryLimit-memoryLimit/10) {
+    return true;
+  }
+
+  Timer::syncClock();
+  unsigned now = milliToDeci(env.timer->elapsedMilliseconds());
+
+  Sample* s;
+  if (_samples.getValuePtr(pid,s) || s->activations!=e.activations) {
+    s->time = now;
+    s->activations = e.activations;
+    return false;
+  }
+  return now >= s->time+STAGNATION_TIME;
+}
+
+void PortfolioDynamicPriorityPolicy::processTerminated(pid_t pid)
+{
+  CALL("PortfolioDynamicPriorityPolicy::processTerminated");
+
+  _samples.remove(pid);
+  _board->release(pid);
+}
+
 PortfolioSliceExecutor::PortfolioSliceExecutor(PortfolioMode *mode)
   : _mode(mode)
 {}
@@ -313,6 +374,18 @@ void PortfolioSliceExecutor::runSlice
   }
 }
 
+PortfolioGroupExecutor::PortfolioGroupExecutor(PortfolioMode *mode)
+  : _mode(mode)
+{}
+
+void PortfolioGroupExecutor::runSlice
+  (vstring groupCode, int terminationTime)
+{
+  unsigned groupIndex;
+  ALWAYS(Int::stringToUnsignedInt(groupCode,groupIndex));
+  _mode->runGroup(groupIndex, terminationTime);
+}
+
 /**
  * Run a schedule.
  * Return true if a proof was found, otherwise return false.
@@ -323,13 +396,169 @@ bool PortfolioMode::runSchedule(Schedule& schedule, int terminationTime)
 
   UIHelper::portfolioParent = true; // to report on overall-solving-ended in Timer.cpp
 
-  PortfolioProcessPriorityPolicy policy;
+  if (env.options->sharedPreprocessing()) {
+    return runScheduleSharingPreprocessing(schedule, terminationTime);
+  }
+
+  return runSlices(schedule, terminationTime, ScheduleExecutor::getNumWorkers());
+}
+
+/**
+ * Run the strategies of @b schedule, at most @b numWorkers of them at
+ * the same time.
+ *
+ * Return true if a proof was found, otherwise return false.
+ */
+bool PortfolioMode::runSlices(Schedule& schedule, int terminationTime, unsigned numWorkers)
+{
+  CALL("PortfolioMode::runSlices");
+
   PortfolioSliceExecutor executor(this);
-  ScheduleExecutor sched(&policy, &executor);
+
+  if (env.options->dynamicScheduling()) {
+    // must be created before the strategies are forked, so that they report to it
+    Sys::ProgressBoard* board = new Sys::ProgressBoard(2*numWorkers);
+    Sys::ProgressBoard::setInstance(board);
+
+    PortfolioDynamicPriorityPolicy policy(board);
+    ScheduleExecutor sched(&policy, &executor, numWorkers);
+    bool success = sched.run(schedule, terminationTime);
+
+    Sys::ProgressBoard::setInstance(0);
+    delete board;
+    return success;
+  }
+
+  PortfolioProcessPriorityPolicy policy;
+  ScheduleExecutor sched(&policy, &executor, numWorkers);
 
   return sched.run(schedule, terminationTime);
 }
 
+/**
+ * Run a schedule so that the problem is preprocessed only once for each
+ * group of strategies with the same preprocessing options.
+ *
+ * For each group we fork a process that preprocesses the problem and then
+ * forks the strategies of the group from the preprocessed problem, so they
+ * can start saturation right away. The groups keep the order in which
+ * their first strategies appear in @b schedule.
+ *
+ * Return true if a proof was found, otherwise return false.
+ */
+bool PortfolioMode::runScheduleSharingPreprocessing(Schedule& schedule, int terminationTime)
+{
+  CALL("PortfolioMode::runScheduleSharingPreprocessing");
+
+  DHMap<vstring,unsigned> groupIndexes;
+  Schedule groupCodes;
+
+  Schedule::BottomFirstIterator it(schedule);
+  while (it.hasNext()) {
+    vstring code = it.next();
+
+    // the strategies themselves will report on unknown options
+    Options opt = *env.options;
+    if (opt.ignoreMissing()==Options::IgnoreMissing::WARN) {
+      opt.setIgnoreMissing(Options::IgnoreMissing::ON);
+    }
+    vstring fingerprint;
+    try {
+      opt.readFromEncodedOptions(code);
+      opt.setNormalize(false);
+      opt.setForcedOptionValues();
+      fingerprint = opt.preprocessingFingerprint();
+    }
+    catch(UserErrorException&) {
+      // let the strategy fail on its own
+      fingerprint = code;
+    }
+
+    unsigned* pIndex;
+    if (groupIndexes.getValuePtr(fingerprint,pIndex)) {
+      *pIndex = _groups.size();
+      _groups.push(Schedule());
+      groupCodes.push(Int::toString(*pIndex));
+    }
+    _groups[*pIndex].push(code);
+  }
+
+  if (_groups.isEmpty()) {
+    return false;
+  }
+
+  unsigned workers = ScheduleExecutor::getNumWorkers();
+  unsigned groupProcesses = min(workers, (unsigned)_groups.size());
+  _groupWorkers = max(1u, workers / groupProcesses);
+
+  PortfolioProcessPriorityPolicy policy;
+  PortfolioGroupExecutor executor(this);
+  ScheduleExecutor sched(&policy, &executor, groupProcesses);
+
+  return sched.run(groupCodes, terminationTime);
+}
+
+/**
+ * Preprocess the problem with the options of the strategies of the group
+ * @b groupIndex and run the strategies on the preprocessed problem.
+ *
+ * Exits with zero status iff a proof was found.
+ */
+void PortfolioMode::runGroup(unsigned groupIndex, int terminationTime)
+{
+  CALL("PortfolioMode::runGroup");
+
+  System::registerForSIGHUPOnParentDeath();
+
+  Schedule& group = _groups[groupIndex];
+  ASS(group.isNonEmpty());
+
+  // the strategies only differ in options that do not affect preprocessing,
+  // so any of them can be used to preprocess
+  // the strategies themselves will report on unknown options; we must not
+  // produce any output here as the strategies are yet to be forked
+  Options opt = *env.options;
+  if (opt.ignoreMissing()==Options::IgnoreMissing::WARN) {
+    opt.setIgnoreMissing(Options::IgnoreMissing::ON);
+  }
+
+  try {
+    opt.readFromEncodedOptions(group[0]);
+    opt.setNormalize(false);
+    opt.setForcedOptionValues();
+    opt.checkGlobalOptionConstraints();
+
+    Options original = *env.options;
+    *env.options = opt; // the preprocessing reads some options from env.options
+    {
+      TimeCounter tc(TC_PREPROCESSING);
+
+      Preprocess prepro(opt);
+      prepro.preprocess(*_prb);
+    }
+    *env.options = original;
+  }
+  catch(Exception &e) {
+    if(outputAllowed()) {
+      std::cerr << "% Exception at shared preprocessing level" << std::endl;
+      e.cry(std::cerr);
+    }
+    System::terminateImmediately(1); // didn't find proof
+  }
+  _prbPreprocessed = true;
+
+  if (env.options->clauseSharing()) {
+    // must be created before the strategies are forked, so that they share it
+    Saturation::ClauseSharing::setInstance(new Saturation::ClauseSharing(group));
+  }
+
+  bool success = runSlices(group, terminationTime, _groupWorkers);
+
+  STOP_CHECKING_FOR_ALLOCATOR_BYPASSES;
+
+  exit(success ? 0 : 1);
+} // runGroup
+
 /**
  * Return the intended slice time in deciseconds and assign the slice
  * vstring with chopped time limit to @b chopped.
@@ -394,6 +623,10 @@ void PortfolioMode::runSlice(vstring sliceCode, unsigned timeLimitInDeciseconds)
 {
   CALL("PortfolioMode::runSlice");
 
+  if (Saturation::ClauseSharing::instance()) {
+    Saturation::ClauseSharing::instance()->setStrategy(sliceCode);
+  }
+
   Options opt = *env.options;
   opt.readFromEncodedOptions(sliceCode);
   opt.setTimeLimitInDeciseconds(timeLimitInDeciseconds);
@@ -433,7 +666,12 @@ void PortfolioMode::runSlice(Options& strategyOpt)
     env.endOutput();
   }
 
-  Saturation::ProvingHelper::runVampire(*_prb, opt);
+  if (_prbPreprocessed) {
+    Saturation::ProvingHelper::runVampireSaturation(*_prb, opt);
+  }
+  else {
+    Saturation::ProvingHelper::runVampire(*_prb, opt);
+  }
 
   //set return value to zero if we were successful
   if (env.statistics->terminationReason == Statistics::REFUTATION ||
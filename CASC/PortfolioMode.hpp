@@ -26,6 +26,7 @@
 
 #include "Forwards.hpp"
 
+#include "Lib/DHMap.hpp"
 #include "Lib/Portability.hpp"
 #include "Lib/ScopedPtr.hpp"
 #include "Lib/Set.hpp"
@@ -55,6 +56,31 @@ public:
   float dynamicPriority(pid_t pid) override;
 };
 
+/**
+ * One-after-the-other priority, which in addition terminates the running
+ * slices that stopped making progress, so that the waiting slices can
+ * start earlier. The slices report their progress to a ProgressBoard.
+ */
+class PortfolioDynamicPriorityPolicy : public PortfolioProcessPriorityPolicy
+{
+public:
+  PortfolioDynamicPriorityPolicy(Sys::ProgressBoard* board);
+  unsigned watchInterval() override;
+  bool shouldTerminate(pid_t pid) override;
+  void processTerminated(pid_t pid) override;
+
+private:
+  struct Sample {
+    /** Time in deciseconds when the number of activations last changed */
+    unsigned time;
+    unsigned activations;
+  };
+
+  Sys::ProgressBoard* _board;
+  /** The last sample of each slice */
+  DHMap<pid_t,Sample> _samples;
+};
+
 class PortfolioSliceExecutor : public SliceExecutor
 {
 public:
@@ -65,6 +91,20 @@ private:
   PortfolioMode *_mode;
 };
 
+/**
+ * Executor whose "slices" are groups of strategies sharing the same
+ * preprocessing. The slice code is the index of the group.
+ */
+class PortfolioGroupExecutor : public SliceExecutor
+{
+public:
+  PortfolioGroupExecutor(PortfolioMode *mode);
+  void runSlice(vstring groupCode, int terminationTime) override;
+
+private:
+  PortfolioMode *_mode;
+};
+
 class PortfolioMode {
   enum {
     SEM_LOCK = 0,
@@ -74,6 +114,8 @@ class PortfolioMode {
   PortfolioMode();
   friend void PortfolioSliceExecutor::runSlice
     (vstring sliceCode, int terminationTime);
+  friend void PortfolioGroupExecutor::runSlice
+    (vstring groupCode, int terminationTime);
 public:
   static bool perform(float slowness);
   unsigned getSliceTime(vstring sliceCode,vstring& chopped);
@@ -86,6 +128,9 @@ private:
   bool performStrategy(Shell::Property* property);
   void getSchedules(Property& prop, Schedule& quick, Schedule& fallback);
   bool runSchedule(Schedule& schedule, int terminationTime);
+  bool runSlices(Schedule& schedule, int terminationTime, unsigned numWorkers);
+  bool runScheduleSharingPreprocessing(Schedule& schedule, int terminationTime);
+  void runGroup(unsigned groupIndex, int terminationTime) NO_RETURN;
   bool waitForChildAndCheckIfProofFound();
   void runSlice(vstring slice, unsigned timeLimitInDeciseconds) NO_RETURN;
   void runSlice(Options& strategyOpt) NO_RETURN;
@@ -103,6 +148,16 @@ private:
    * will be using the problem object.
    */
   ScopedPtr<Problem> _prb;
+  /**
+   * True if @b _prb has already been preprocessed, which happens in the
+   * group processes of the shared_preprocessing mode.
+   */
+  bool _prbPreprocessed;
+
+  /** Groups of strategies with the same preprocessing options */
+  Stack<Schedule> _groups;
+  /** Number of strategies a group process may run in parallel */
+  unsigned _groupWorkers;
 
   Semaphore _syncSemaphore; // semaphore for synchronizing proof printing
 };
@@ -22,6 +22,17 @@ ScheduleExecutor::ScheduleExecutor(ProcessPriorityPolicy *policy, SliceExecutor
   _numWorkers = getNumWorkers();
 }
 
+/**
+ * Create an executor running at most @b numWorkers slices at the same time
+ * regardless of the cores option.
+ */
+ScheduleExecutor::ScheduleExecutor(ProcessPriorityPolicy *policy, SliceExecutor *executor, unsigned numWorkers)
+  : _policy(policy), _executor(executor), _numWorkers(numWorkers)
+{
+  CALL("ScheduleExecutor::ScheduleExecutor/3");
+  ASS_G(numWorkers,0);
+}
+
 class Item
 {
 public:
@@ -92,14 +103,41 @@ bool ScheduleExecutor::run(const Schedule &schedule, int terminationTime)
 
     bool stopped, exited;
     int code;
-    // sleep until process changes state
-    pid_t process = Multiprocessing::instance()
-      ->poll_children(stopped, exited, code);
+    pid_t process;
+    unsigned watchInterval = _policy->watchInterval();
+    if(watchInterval)
+    {
+      // check the running processes regularly while some slices wait
+      process = Multiprocessing::instance()
+        ->poll_children(stopped, exited, code, queue.isEmpty());
+      if(!process)
+      {
+        Pool::Iterator pit(pool);
+        while(pit.hasNext())
+        {
+          pid_t running = pit.next();
+          if(_policy->shouldTerminate(running))
+          {
+            // will be removed from the pool once we see it exit
+            Multiprocessing::instance()->killNoCheck(running, SIGKILL);
+          }
+        }
+        Multiprocessing::instance()->sleep(watchInterval*100);
+        continue;
+      }
+    }
+    else
+    {
+      // sleep until process changes state
+      process = Multiprocessing::instance()
+        ->poll_children(stopped, exited, code);
+    }
 
     // child died, remove it from the pool and check if succeeded
     if(exited)
     {
       pool = Pool::remove(process, pool);
+      _policy->processTerminated(process);
       if(!code)
       {
         success = true;
@@ -12,6 +12,16 @@ class ProcessPriorityPolicy
 public:
   virtual float staticPriority(Lib::vstring sliceCode) = 0;
   virtual float dynamicPriority(pid_t pid) = 0;
+
+  /**
+   * Interval in deciseconds in which the running processes should be
+   * offered to @b shouldTerminate, zero if they should not be watched
+   */
+  virtual unsigned watchInterval() { return 0; }
+  /** Return true if the running process @b pid should make room for the waiting slices */
+  virtual bool shouldTerminate(pid_t pid) { return false; }
+  /** Called when the process @b pid has terminated */
+  virtual void processTerminated(pid_t pid) {}
 };
 
 class SliceExecutor
@@ -24,11 +34,13 @@ class ScheduleExecutor
 {
 public:
   ScheduleExecutor(ProcessPriorityPolicy *policy, SliceExecutor *executor);
+  ScheduleExecutor(ProcessPriorityPolicy *policy, SliceExecutor *executor, unsigned numWorkers);
   bool run(const Schedule &schedule, int terminationTime);
 
+  static unsigned getNumWorkers();
+
 private:
   pid_t spawn(Lib::vstring code, int terminationTime);
-  unsigned getNumWorkers();
 
   ProcessPriorityPolicy *_policy;
   SliceExecutor *_executor;
@@ -69,6 +69,14 @@ public:
   virtual void getUnsatCore(LiteralStack& res, unsigned coreIndex=0) = 0;
   /** reset decision procedure object into state equivalent to its initial state */
   virtual void reset() = 0;
+
+  /**
+   * Open a backtracking level. Literals added after this call
+   * are retracted by the matching call to pop().
+   */
+  virtual void push() = 0;
+  /** Retract the literals added since the last @c levels calls to push() */
+  virtual void pop(unsigned levels=1) = 0;
 };
 
 }
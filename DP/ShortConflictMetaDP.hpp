@@ -63,6 +63,17 @@ public:
     _unsatCores.reset();
   }
 
+  virtual void push() override {
+    CALL("ShortConflictMetaDP::push");
+    _inner->push();
+  }
+
+  virtual void pop(unsigned levels) override {
+    CALL("ShortConflictMetaDP::pop");
+    _inner->pop(levels);
+    _unsatCores.reset();
+  }
+
   virtual Status getStatus(bool getMultipleCores) override;
 
   void getModel(LiteralStack& model) override {
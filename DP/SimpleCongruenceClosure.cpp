@@ -169,10 +169,15 @@ void SimpleCongruenceClosure::reset()
 {
   CALL("SimpleCongruenceClosure::reset");
 
+  if(_levels.isNonEmpty()) {
+    pop(_levels.size());
+  }
+
 #if 0
   _cInfos.expand(1);
   _sigConsts.reset();
   _pairNames.reset();
+  _derefPairNames.reset();
   _termNames.reset();
   _litNames.reset();
 
@@ -189,16 +194,7 @@ void SimpleCongruenceClosure::reset()
     _cInfos[i].resetEquivalences(*this, i);
   }
 
-  PairMap::DelIterator pmit(_pairNames);
-  while(pmit.hasNext()) {
-    CPair namePair;
-    unsigned nameConst;
-    pmit.next(namePair, nameConst);
-
-    if(_cInfos[nameConst].namedPair!=namePair) {
-      pmit.del();
-    }
-  }
+  _derefPairNames.reset();
 
   //this leaves us just with the true!=false non-equality
   _negEqualities.truncate(1);
@@ -216,6 +212,147 @@ void SimpleCongruenceClosure::reset()
   _hadPropagated = false;
 }
 
+/**
+ * Open a backtracking level. The pending equalities are
+ * propagated first, so that they stay below the level.
+ */
+void SimpleCongruenceClosure::push()
+{
+  CALL("SimpleCongruenceClosure::push");
+
+  propagate();
+
+  Level lev;
+  lev.trailSize = _trail.size();
+  lev.negEqualities = _negEqualities.size();
+  lev.distincts = _distinctConstraints.size();
+  lev.negDistincts = _negDistinctConstraints.size();
+  _levels.push(lev);
+}
+
+/**
+ * Retract the literals added since the last @c levels calls to push()
+ * and undo the merges they caused. The constants introduced for their
+ * terms are kept for later use.
+ */
+void SimpleCongruenceClosure::pop(unsigned levels)
+{
+  CALL("SimpleCongruenceClosure::pop");
+  ASS_G(levels,0);
+  ASS_LE(levels,_levels.size());
+
+  _levels.truncate(_levels.size()-levels+1);
+  Level lev = _levels.pop();
+
+  while(_trail.size()>lev.trailSize) {
+    undo(_trail.pop());
+  }
+  _negEqualities.truncate(lev.negEqualities);
+  _distinctConstraints.truncate(lev.distincts);
+  _negDistinctConstraints.truncate(lev.negDistincts);
+
+  // the pending queue was empty when the level was opened
+  _pendingEqualities.reset();
+  _unsatEqs.reset();
+
+  // pair names created inside the popped levels survive, but their
+  // registration with representatives merged below the levels does not
+  while(_pairNamesToRegister.isNonEmpty()) {
+    registerPairName(_pairNamesToRegister.pop());
+  }
+}
+
+/** Undo a change recorded on the trail */
+void SimpleCongruenceClosure::undo(const TrailEntry& e)
+{
+  CALL("SimpleCongruenceClosure::undo");
+
+  switch(e.kind) {
+  case TrailKind::USE_LIST:
+  {
+    // elements that survive the pop may have been pushed after this one,
+    // but the order of the useList does not matter
+    Stack<unsigned>& useList = _cInfos[e.c].useList;
+    unsigned idx = useList.size();
+    do {
+      ASS_G(idx,0);
+      idx--;
+    } while(useList[idx]!=e.other);
+    swap(useList[idx], useList.top());
+    useList.pop();
+    break;
+  }
+  case TrailKind::DEREF_PAIR_NAME:
+    ALWAYS(_derefPairNames.remove(e.pair));
+    break;
+  case TrailKind::MERGE:
+  {
+    Stack<unsigned>& classList = _cInfos[e.other].classList;
+    while(classList.size()>e.size) {
+      unsigned member = classList.pop();
+      _cInfos[member].reprConst = (member==e.c) ? 0 : e.c;
+    }
+    break;
+  }
+  case TrailKind::PROOF_EDGE:
+    _cInfos[e.c].proofPredecessor = e.other;
+    _cInfos[e.c].predecessorPremise = e.premise;
+    break;
+  case TrailKind::PAIR_NAME:
+    _pairNamesToRegister.push(e.c);
+    break;
+  }
+}
+
+/** Record the proof predecessor of @c c before it changes */
+void SimpleCongruenceClosure::recordProofEdge(unsigned c)
+{
+  CALL("SimpleCongruenceClosure::recordProofEdge");
+
+  if(!recording()) {
+    return;
+  }
+  TrailEntry e(TrailKind::PROOF_EDGE, c);
+  e.other = _cInfos[c].proofPredecessor;
+  e.premise = _cInfos[c].predecessorPremise;
+  _trail.push(e);
+}
+
+/**
+ * Push @c pairName to the useList of @c c. If @c backtrackable is false,
+ * the element stays there also when the current level is popped.
+ */
+void SimpleCongruenceClosure::pushToUseList(unsigned c, unsigned pairName, bool backtrackable)
+{
+  CALL("SimpleCongruenceClosure::pushToUseList");
+
+  _cInfos[c].useList.push(pairName);
+  if(backtrackable) {
+    record(TrailEntry(TrailKind::USE_LIST, c, pairName));
+  }
+}
+
+/**
+ * Find a name of a pair congruent with the pair of representatives @c p
+ */
+bool SimpleCongruenceClosure::findDerefPairName(CPair p, unsigned& res)
+{
+  CALL("SimpleCongruenceClosure::findDerefPairName");
+  ASS(deref(p)==p);
+
+  return _pairNames.find(p, res) || _derefPairNames.find(p, res);
+}
+
+void SimpleCongruenceClosure::addDerefPairName(CPair p, unsigned name)
+{
+  CALL("SimpleCongruenceClosure::addDerefPairName");
+
+  ALWAYS(_derefPairNames.insert(p, name));
+  TrailEntry e(TrailKind::DEREF_PAIR_NAME, name);
+  e.pair = p;
+  record(e);
+}
+
 /** Introduce fresh congruence closure constant */
 unsigned SimpleCongruenceClosure::getFreshConst()
 {
@@ -256,22 +393,57 @@ unsigned SimpleCongruenceClosure::getPairName(CPair p)
   _cInfos[res].namedPair = p;
   *pRes = res;
 
-  _cInfos[p.first].useList.push(res);
+  // the pair name is kept when levels are popped, so it stays in the
+  // useLists of the arguments
+  // Martin: if the arguments have other representatives, this insertion
+  // is not needed now, but will become necessary after reset(); see
+  // resetEquivalences
+  pushToUseList(p.first, res, false);
+  pushToUseList(p.second, res, false);
+
+  registerPairName(res);
+  return res;
+}
+
+/**
+ * Make the pair name @c name known to the current representatives of
+ * its arguments, and make it equal to a congruent pair name if there is
+ * one already.
+ *
+ * This depends on the merges done so far, so if it is undone by pop()
+ * while the name is kept, it is done again.
+ */
+void SimpleCongruenceClosure::registerPairName(unsigned name)
+{
+  CALL("SimpleCongruenceClosure::registerPairName");
+
+  CPair p = _cInfos[name].namedPair;
+  bool dependsOnMerges = false;
   if(_cInfos[p.first].reprConst!=0) {
-    // Martin: if we are here, the above insertion was not needed now,
-    // but will become necessary after reset(); see resetEquivalences
-    unsigned fRepr = _cInfos[p.first].reprConst;
-    _cInfos[fRepr].useList.push(res);
+    pushToUseList(_cInfos[p.first].reprConst, name);
+    dependsOnMerges = true;
   }
-  _cInfos[p.second].useList.push(res);
   if(_cInfos[p.second].reprConst!=0) {
-    // Martin: if we are here, the above insertion was not needed now,
-    // but will become necessary after reset(); see resetEquivalences
-    unsigned sRepr = _cInfos[p.second].reprConst;
-    _cInfos[sRepr].useList.push(res);
+    pushToUseList(_cInfos[p.second].reprConst, name);
+    dependsOnMerges = true;
   }
 
-  return res;
+  // after propagation, there may already be a congruent pair
+  CPair derefPair = deref(p);
+  unsigned congruentName;
+  if((_derefPairNames.find(derefPair, congruentName) ||
+      (derefPair!=p && _pairNames.find(derefPair, congruentName))) &&
+     congruentName!=name) {
+    addPendingEquality(CEq(congruentName, name));
+    dependsOnMerges = true;
+  }
+  else if(derefPair!=p && !_derefPairNames.find(derefPair)) {
+    addDerefPairName(derefPair, name);
+  }
+
+  if(dependsOnMerges) {
+    record(TrailEntry(TrailKind::PAIR_NAME, name));
+  }
 }
 
 struct SimpleCongruenceClosure::FOConversionWorker
@@ -444,7 +616,7 @@ SimpleCongruenceClosure::CEq SimpleCongruenceClosure::convertFOEquality(Literal*
 void SimpleCongruenceClosure::addLiterals(LiteralIterator lits, bool onlyEqualites)
 {
   CALL("SimpleCongruenceClosure::addLiterals");
-  ASS(!_hadPropagated);
+  ASS(!_hadPropagated || recording());
 
   while(lits.hasNext()) {
     Literal* l = lits.next();
@@ -514,6 +686,7 @@ void SimpleCongruenceClosure::makeProofRepresentant(unsigned c)
   unsigned prevC = 0;
 
   do{
+    recordProofEdge(c);
     unsigned newC = _cInfos[c].proofPredecessor;
     _cInfos[c].proofPredecessor = prevC;
     swap(_cInfos[c].predecessorPremise, transfPrem);
@@ -551,6 +724,7 @@ void SimpleCongruenceClosure::propagate()
       unsigned aProofRep = curr0.c1;
       unsigned bProofRep = curr0.c2;
       makeProofRepresentant(aProofRep);
+      recordProofEdge(aProofRep);
       ConstInfo& aProofInfo = _cInfos[aProofRep];
       ASS_EQ(aProofInfo.proofPredecessor,0);
       aProofInfo.proofPredecessor = bProofRep;
@@ -572,6 +746,12 @@ void SimpleCongruenceClosure::propagate()
     // Merge first class into second (which is why we wanted the first to be smaller)
     // To do this we update the representative for all constants in
     // the class of aRep to be bRep
+    if(recording()) {
+      TrailEntry e(TrailKind::MERGE, aRep);
+      e.other = bRep;
+      e.size = bInfo.classList.size();
+      _trail.push(e);
+    }
     aInfo.reprConst = bRep;
     bInfo.classList.push(aRep);
     Stack<unsigned>::Iterator aChildIt(aInfo.classList);
@@ -590,13 +770,13 @@ void SimpleCongruenceClosure::propagate()
       CPair derefPair = deref(usedPair);
       ASS(usedPair!=derefPair); // Martin: (at least) one of the arguments was aRep, now is bRep
 
-      unsigned* pDerefPairName;
-      if(!_pairNames.getValuePtr(derefPair, pDerefPairName)) {
-	addPendingEquality(CEq(*pDerefPairName, usePairConst));
+      unsigned derefPairName;
+      if(findDerefPairName(derefPair, derefPairName)) {
+	addPendingEquality(CEq(derefPairName, usePairConst));
       }
       else {
-	*pDerefPairName = usePairConst;
-	bInfo.useList.push(usePairConst);
+	addDerefPairName(derefPair, usePairConst);
+	pushToUseList(bRep, usePairConst);
       }
     }
   }
@@ -680,6 +860,9 @@ DecisionProcedure::Status SimpleCongruenceClosure::getStatus(bool retrieveMultip
 {
   CALL("SimpleCongruenceClosure::getStatus");
 
+  // cores of a previous call could refer to retracted literals
+  _unsatEqs.reset();
+
   // Propagate any pending equalities
   propagate();
 
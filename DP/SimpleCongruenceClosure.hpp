@@ -49,10 +49,16 @@ using namespace Kernel;
  * explanations [the unsat core extraction] seem to be simpler and suboptimal 
  * -- the HighestNode trick ? )
  * 
- * Hint: understand _pairNames as "Lookup" from the paper.
+ * Hint: understand _pairNames together with _derefPairNames as "Lookup" from the paper.
  * 
  * However, classList of a representative 
  * does not (physically) contain that representative (only logically)
+ *
+ * The closure is incremental: push() opens a backtracking level and
+ * pop() undoes the merges done since, by replaying a trail of changes
+ * backwards. The conversion of terms to constants is kept, as in reset(),
+ * so successive queries that differ only in a few literals need to
+ * merge only those literals.
  */
 class SimpleCongruenceClosure : public DecisionProcedure
 {
@@ -72,6 +78,9 @@ public:
   
   virtual void reset() override;
 
+  virtual void push() override;
+  virtual void pop(unsigned levels=1) override;
+
   /**
    * New, more fine-grained way of insertion. The terms may contain variables which are treated as constants.
    */
@@ -133,6 +142,7 @@ private:
   unsigned getFreshConst();
   unsigned getSignatureConst(unsigned symbol, SignatureKind kind);
   unsigned getPairName(CPair p);
+  void registerPairName(unsigned name);
 
 
   struct FOConversionWorker;
@@ -250,6 +260,55 @@ private:
     TermList normalForm;    
   };
 
+  /** Kinds of changes recorded on the trail */
+  enum class TrailKind {
+    /** @c other was pushed to the useList of @c c */
+    USE_LIST,
+    /** @c pair was added to _derefPairNames */
+    DEREF_PAIR_NAME,
+    /** the representative @c c was merged into @c other whose classList had @c size elements */
+    MERGE,
+    /** the proof predecessor of @c c was @c other with premise @c premise */
+    PROOF_EDGE,
+    /** the pair name @c c was registered with the representatives of its arguments */
+    PAIR_NAME
+  };
+
+  /** A change that pop() has to undo */
+  struct TrailEntry
+  {
+    TrailEntry(TrailKind kind, unsigned c, unsigned other=0) : kind(kind), c(c), other(other), size(0) {}
+
+    TrailKind kind;
+    unsigned c;
+    unsigned other;
+    unsigned size;
+    CPair pair;
+    CEq premise;
+  };
+
+  /** What has to be restored when a backtracking level is popped */
+  struct Level
+  {
+    unsigned trailSize;
+    unsigned negEqualities;
+    unsigned distincts;
+    unsigned negDistincts;
+  };
+
+  /** Changes are recorded only when there is a level to pop */
+  bool recording() const { return _levels.isNonEmpty(); }
+  void record(const TrailEntry& e) {
+    if(recording()) {
+      _trail.push(e);
+    }
+  }
+  void recordProofEdge(unsigned c);
+  void pushToUseList(unsigned c, unsigned pairName, bool backtrackable=true);
+  bool findDerefPairName(CPair p, unsigned& res);
+  void addDerefPairName(CPair p, unsigned name);
+  void undo(const TrailEntry& e);
+
   struct ConstOrderingComparator;  
   typedef DHMap<unsigned,TermList> NFMap;
   void computeConstsNormalForm(unsigned c, NFMap& normalForms);
@@ -278,8 +337,13 @@ private:
   DHMap<pair<unsigned,SignatureKind>,unsigned> _sigConsts;
 
   typedef DHMap<CPair,unsigned> PairMap;
-  /** Names of constant pairs (modulo the congruence!)*/
+  /** Names of constant pairs, the name of each pair has it as its namedPair */
   PairMap _pairNames;
+  /**
+   * Names of pairs of representatives that were not given a name of their own.
+   * They are names of congruent pairs, found by propagation.
+   */
+  PairMap _derefPairNames;
 
   /** Constants corresponding to terms */
   DHMap<TermList,unsigned> _termNames;
@@ -309,10 +373,17 @@ private:
   DistinctStack _negDistinctConstraints;
 
   /**
-   * used to assert we don't add literals after propagation.
-   * this would cause problems with term caches upon reset.
+   * used to assert we don't add literals after propagation
+   * outside of a backtracking level.
    */
   bool _hadPropagated;
+
+  /** Open backtracking levels */
+  Stack<Level> _levels;
+  /** Changes done since the first open level, in the order they were done */
+  Stack<TrailEntry> _trail;
+  /** Pair names whose registration was undone by pop() and has to be redone */
+  Stack<unsigned> _pairNamesToRegister;
 }; // class SimpleCongruenceClosure
 
 }
@@ -42,6 +42,7 @@
 #include "SAT/Preprocess.hpp"
 #include "SAT/TWLSolver.hpp"
 #include "SAT/MinisatInterfacingNewSimp.hpp"
+#include "SAT/LingelingInterfacing.hpp"
 #include "SAT/BufferedSolver.hpp"
 
 #include "Lib/Environment.hpp"
@@ -257,11 +258,16 @@ bool FiniteModelBuilder::reset(){
     offsets += add;
   }
 
-  // Create a new SAT solver
-  try{
-    _solver = new MinisatInterfacingNewSimp(_opt,true);
-  }catch(Minisat::OutOfMemoryException&){
-    MinisatInterfacingNewSimp::reportMinisatOutOfMemory();
+  // Create a new SAT solver, minisat unless lingeling is asked for
+  if(_opt.satSolver() == Options::SatSolver::LINGELING){
+    _solver = new LingelingInterfacing(_opt,true);
+  }
+  else{
+    try{
+      _solver = new MinisatInterfacingNewSimp(_opt,true);
+    }catch(Minisat::OutOfMemoryException&){
+      MinisatInterfacingNewSimp::reportMinisatOutOfMemory();
+    }
   }
 
   /*
@@ -105,6 +105,7 @@ template <typename Val, class Hash1=FIRST_HASH(Val), class Hash2=Hash> class DHS
 template <typename K,typename V, class Hash1=FIRST_HASH(K), class Hash2=Hash> class MapToLIFO;
 
 template <typename Val,class Hash=Lib::Hash> class Set;
+template <typename Val,class Hash=Lib::Hash> class InsertOnlySet;
 
 
 template <typename Value,class ValueComparator> class SkipList;
@@ -118,6 +119,7 @@ class Timer;
 
 namespace Sys
 {
+class ProgressBoard;
 class Semaphore;
 class SyncPipe;
 }
@@ -325,6 +327,7 @@ class Splitter;
 class ConsequenceFinder;
 class LabelFinder;
 class SymElOutput;
+class ClauseSharing;
 }
 
 namespace Inferences
@@ -381,6 +384,7 @@ class AnswerLiteralManager;
 class LaTeX;
 class Options;
 class Property;
+class SineTheorySelector;
 class Statistics;
 
 class EPRRestoring;
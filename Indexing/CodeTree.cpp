@@ -1466,70 +1466,73 @@ bool CodeTree::Matcher::execute()
     }
   }
 
-
-  bool shouldBacktrack=false;
-  for(;;) {
-    if(op->alternative()) {
-      btStack.push(BTPoint(tp, op->alternative()));
-    }
-    switch(op->instrPrefix()) {
-    case SUCCESS_OR_FAIL:
-      if(op->isFail()) {
-	shouldBacktrack=true;
-	break;
-      }
-      //yield successes only in the first round (we don't want to yield the
-      //same thing for each query literal)
-      if(curLInfo==0) {
-	return true;
-      }
-      else {
-	shouldBacktrack=true;
-      }
-      break;
-    case LIT_END:
-      return true;
-    case CHECK_GROUND_TERM:
-      shouldBacktrack=!doCheckGroundTerm();
-      break;
-    case SUFFIX_INSTR:
-      switch(op->instrSuffix()) {
-      case CHECK_FUN:
-        shouldBacktrack=!doCheckFun();
-        break;
-      case ASSIGN_VAR:
-        doAssignVar();
-        break;
-      case CHECK_VAR:
-        shouldBacktrack=!doCheckVar();
-        break;
-      case SEARCH_STRUCT:
-	if(doSearchStruct()) {
-	  //a new value of @b op is assigned, so restart the loop
-	  continue;
-	}
-	else {
-	  shouldBacktrack=true;
-	}
-	break;
-      }
-      break;
-    }
-    if(shouldBacktrack) {
-      if(!backtrack()) {
-	return false;
-      }
-      shouldBacktrack=false;
-    }
-    else {
-      //the SEARCH_STRUCT operation does not appear in CodeBlocks
-      ASS(!op->isSearchStruct());
-      //In each CodeBlock there is always either operation LIT_END or FAIL.
-      //As we haven't encountered one yet, we may safely increase the
-      //operation pointer
-      op++;
-    }
+  //indexed by CodeOp::instrBits(), the suffix bits matter only for SUFFIX_INSTR
+  static void* const instrLabels[16] = {
+    &&successOrFail, &&checkGroundTerm, &&litEnd, &&checkFun,
+    &&successOrFail, &&checkGroundTerm, &&litEnd, &&assignVar,
+    &&successOrFail, &&checkGroundTerm, &&litEnd, &&checkVar,
+    &&successOrFail, &&checkGroundTerm, &&litEnd, &&searchStruct
+  };
+
+#define CT_DISPATCH \
+  if(op->alternative()) { \
+    btStack.push(BTPoint(tp, op->alternative())); \
+  } \
+  goto *instrLabels[op->instrBits()]
+
+  //the SEARCH_STRUCT operation does not appear in CodeBlocks. In each
+  //CodeBlock there is always either operation LIT_END or FAIL, so we may
+  //safely increase the operation pointer after other operations
+#define CT_NEXT \
+  ASS(!op->isSearchStruct()); \
+  op++; \
+  CT_DISPATCH
+
+#define CT_BACKTRACK \
+  if(!backtrack()) { \
+    return false; \
+  } \
+  CT_DISPATCH
+
+  CT_DISPATCH;
+
+successOrFail:
+  //yield successes only in the first round (we don't want to yield the
+  //same thing for each query literal)
+  if(op->isFail() || curLInfo!=0) {
+    CT_BACKTRACK;
   }
+  return true;
+litEnd:
+  return true;
+checkGroundTerm:
+  if(!doCheckGroundTerm()) {
+    CT_BACKTRACK;
+  }
+  CT_NEXT;
+checkFun:
+  if(!doCheckFun()) {
+    CT_BACKTRACK;
+  }
+  CT_NEXT;
+assignVar:
+  doAssignVar();
+  CT_NEXT;
+checkVar:
+  if(!doCheckVar()) {
+    CT_BACKTRACK;
+  }
+  CT_NEXT;
+searchStruct:
+  //a new value of @b op is assigned, so we dispatch on it directly
+  if(!doSearchStruct()) {
+    CT_BACKTRACK;
+  }
+  CT_DISPATCH;
+
+#undef CT_BACKTRACK
+#undef CT_NEXT
+#undef CT_DISPATCH
 }
 
 /**
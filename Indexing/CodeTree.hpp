@@ -231,6 +231,13 @@ public:
       return static_cast<InstructionSuffix>(_info.suffix);
     }
 
+    /**
+     * Return the instruction prefix together with the suffix bits shifted
+     * left by two. The suffix bits are meaningful only for SUFFIX_INSTR,
+     * otherwise they are low bits of the data pointer.
+     */
+    inline unsigned instrBits() const { return _info.prefix | (_info.suffix<<2); }
+
     inline unsigned arg() const { return _info.arg; }
     inline CodeOp* alternative() const { return _alternative; }
     inline CodeOp*& alternative() { return _alternative; }
@@ -32,6 +32,7 @@
 
 #include "SAT/TWLSolver.hpp"
 #include "SAT/MinisatInterfacing.hpp"
+#include "SAT/LingelingInterfacing.hpp"
 #include "SAT/BufferedSolver.hpp"
 
 #include "Saturation/SaturationAlgorithm.hpp"
@@ -54,6 +55,9 @@ GroundingIndex::GroundingIndex(const Options& opt)
     case Options::SatSolver::MINISAT:
       _solver = new MinisatInterfacing(opt,true);
     	break;
+    case Options::SatSolver::LINGELING:
+      _solver = new LingelingInterfacing(opt,true);
+      break;
     default:
       ASSERTION_VIOLATION_REP(opt.satSolver());
   }
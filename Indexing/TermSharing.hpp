@@ -26,7 +26,7 @@
 #ifndef __TermSharing__
 #define __TermSharing__
 
-#include "Lib/Set.hpp"
+#include "Lib/InsertOnlySet.hpp"
 #include "Kernel/Term.hpp"
 
 #include "Lib/Allocator.hpp"
@@ -77,9 +77,9 @@ private:
   bool argNormGt(TermList t1, TermList t2);
 
   /** The set storing all terms */
-  Set<Term*,TermSharing> _terms;
+  InsertOnlySet<Term*,TermSharing> _terms;
   /** The set storing all literals */
-  Set<Literal*,TermSharing> _literals;
+  InsertOnlySet<Literal*,TermSharing> _literals;
   /** Number of terms stored */
   unsigned _totalTerms;
   /** Number of ground terms stored */
@@ -166,12 +166,18 @@ bool ForwardDemodulation::perform(Clause* cl, Clause*& replacement, ClauseIterat
 	  TermList other=EqHelper::getOtherEqualitySide(lit, trm);
 	  Ordering::Result tord=ordering.compare(rhsS, other);
 	  if(tord!=Ordering::LESS && tord!=Ordering::LESS_EQ) {
-	    Literal* eqLitS=qr.substitution->applyToBoundResult(qr.literal);
+	    //the instance of the demodulator is a shared literal, so we build
+	    //it only when there are other literals to compare it with (a unit
+	    //clause is the common case with large sets of unit equalities)
+	    Literal* eqLitS=0;
 	    bool isMax=true;
 	    for(unsigned li2=0;li2<cLen;li2++) {
 	      if(li==li2) {
 		continue;
 	      }
+	      if(!eqLitS) {
+		eqLitS=qr.substitution->applyToBoundResult(qr.literal);
+	      }
 	      if(ordering.compare(eqLitS, (*cl)[li2])==Ordering::LESS) {
 		isMax=false;
 		break;
@@ -23,6 +23,7 @@
 
 
 #include "Lib/VirtualIterator.hpp"
+#include "Lib/BitUtils.hpp"
 #include "Lib/DArray.hpp"
 #include "Lib/List.hpp"
 #include "Lib/Comparison.hpp"
@@ -87,7 +88,7 @@ private:
   ClauseMatches(const ClauseMatches&);
   ClauseMatches& operator=(const ClauseMatches&);
 public:
-  ClauseMatches(Clause* cl) : _cl(cl), _zeroCnt(cl->length())
+  ClauseMatches(Clause* cl) : _cl(cl), _zeroCnt(cl->length()), _filled(false)
   {
     unsigned clen=_cl->length();
     _matches=static_cast<LiteralList**>(ALLOC_KNOWN(clen*sizeof(void*), "Inferences::ClauseMatches"));
@@ -117,6 +118,8 @@ public:
   }
   void fillInMatches(LiteralMiniIndex* miniIndex)
   {
+    ASS(!_filled);
+    _filled=true;
     unsigned blen=_cl->length();
 
     for(unsigned bi=0;bi<blen;bi++) {
@@ -128,9 +131,11 @@ public:
     }
   }
   bool anyNonMatched() { return _zeroCnt; }
+  bool filled() { return _filled; }
 
   Clause* _cl;
   unsigned _zeroCnt;
+  bool _filled;
   LiteralList** _matches;
 
   class ZeroMatchLiteralIterator
@@ -298,12 +303,23 @@ bool ForwardSubsumptionAndResolution::perform(Clause* cl, Clause*& replacement,
 	//we've already checked this clause
 	continue;
       }
+      if(!BitUtils::isSubset(cl->symbolSignature(), mcl->symbolSignature())) {
+	//mcl contains a symbol that cl does not, so it can neither
+	//subsume nor subsumption-resolve cl
+	mcl->setAux(0);
+	continue;
+      }
       unsigned mlen=mcl->length();
       ASS_G(mlen,1);
 
       ClauseMatches* cms=new ClauseMatches(mcl);
       mcl->setAux(cms);
       cmStore.push(cms);
+      if(!BitUtils::bytewiseLessOrEqual(mcl->featureVector(), cl->featureVector())) {
+	//mcl cannot subsume cl, the matches will be filled in only if
+	//they are needed for subsumption resolution
+	continue;
+      }
       //      cms->addMatch(res.literal, (*cl)[li]);
       //      cms->fillInMatches(&miniIndex, res.literal, (*cl)[li]);
       cms->fillInMatches(&miniIndex);
@@ -350,6 +366,9 @@ bool ForwardSubsumptionAndResolution::perform(Clause* cl, Clause*& replacement,
       CMStack::Iterator csit(cmStore);
       while(csit.hasNext()) {
 	ClauseMatches* cms=csit.next();
+	if(!cms->filled()) {
+	  cms->fillInMatches(&miniIndex);
+	}
 	for(unsigned li=0;li<clen;li++) {
 	  Literal* resLit=(*cl)[li];
 	  if(checkForSubsumptionResolution(cl, cms, resLit) && ColorHelper::compatible(cl->color(), cms->_cl->color()) ) {
@@ -375,6 +394,10 @@ bool ForwardSubsumptionAndResolution::perform(Clause* cl, Clause*& replacement,
 	  //we have already examined this clause
 	  continue;
 	}
+	if(!BitUtils::isSubset(cl->symbolSignature(), mcl->symbolSignature())) {
+	  mcl->setAux(0);
+	  continue;
+	}
 
 	ClauseMatches* cms=new ClauseMatches(mcl);
 	res.clause->setAux(cms);
@@ -481,15 +481,12 @@ Clause* Superposition::performSuperposition(
 
   Ordering& ordering = _salg->getOrdering();
 
-  TermList eqLHSS = subst->apply(eqLHS, eqIsResult);
   TermList tgtTermS = subst->apply(tgtTerm, eqIsResult);
-
-  Literal* rwLitS = subst->apply(rwLit, !eqIsResult);
   TermList rwTermS = subst->apply(rwTerm, !eqIsResult);
 
 #if VDEBUG
   if(!hasConstraints){
-    ASS_EQ(rwTermS,eqLHSS);
+    ASS_EQ(rwTermS,subst->apply(eqLHS, eqIsResult));
   }
 #endif
 
@@ -500,6 +497,10 @@ Clause* Superposition::performSuperposition(
     return 0;
   }
 
+  //the instance of the rewritten literal goes through the term sharing,
+  //so we build it only for inferences that pass the ordering check
+  Literal* rwLitS = subst->apply(rwLit, !eqIsResult);
+
   if(rwLitS->isEquality()) {
     //check that we're not rewriting only the smaller side of an equality
     TermList arg0=*rwLitS->nthArgument(0);
@@ -607,6 +608,7 @@ Clause* Superposition::performSuperposition(
     Literal* eqLitS = 0;
     if (afterCheck && eqClause->numSelected() > 1) {
       TimeCounter tc(TC_LITERAL_ORDER_AFTERCHECK);
+      TermList eqLHSS = subst->apply(eqLHS, eqIsResult);
       eqLitS = Literal::createEquality(true,eqLHSS,tgtTermS,sort);
     }
 
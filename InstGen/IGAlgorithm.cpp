@@ -46,6 +46,7 @@
 #include "SAT/SATClause.hpp"
 #include "SAT/TWLSolver.hpp"
 #include "SAT/MinisatInterfacing.hpp"
+#include "SAT/LingelingInterfacing.hpp"
 
 #include "Saturation/SaturationAlgorithm.hpp"
 
@@ -102,6 +103,9 @@ IGAlgorithm::IGAlgorithm(Problem& prb,const Options& opt)
     case Options::SatSolver::MINISAT:
       _satSolver = new MinisatInterfacing(opt,true);
       break;
+    case Options::SatSolver::LINGELING:
+      _satSolver = new LingelingInterfacing(opt,true);
+      break;
 #if VZ3
     case Options::SatSolver::Z3:
       //cout << "Warning: Z3 not compatible with inst_gen, using Minisat" << endl;
@@ -77,6 +77,8 @@ Clause::Clause(unsigned length,InputType it,Inference* inf)
     _numSelected(0),
     _age(0),
     _weight(0),
+    _symbolSignature(0),
+    _featureVector(0),
     _store(NONE),
     _in_active(0),
     _refCnt(0),
@@ -526,6 +528,49 @@ void Clause::computeWeight() const
 
 } // Clause::computeWeight
 
+/**
+ * Compute the symbol signature and the feature vector of the clause.
+ *
+ * In the signature, predicate symbols use the odd bits and function
+ * symbols the even ones. The bytes of the feature vector are the number
+ * of positive literals, the number of negative literals and the numbers
+ * of occurrences of function symbols falling in each of six classes, all
+ * capped at 127 so that they can be compared by
+ * BitUtils::bytewiseLessOrEqual. Instantiation only adds symbol
+ * occurrences, so the features of a clause are bounded by those of any
+ * clause it can be matched into.
+ */
+void Clause::computeSubsumptionFeatures() const
+{
+  CALL("Clause::computeSubsumptionFeatures");
+
+  unsigned long long signature = 0;
+  unsigned char features[8] = {0,0,0,0,0,0,0,0};
+  for (unsigned i = 0; i < _length; i++) {
+    Literal* lit = _literals[i];
+    signature |= 1ull << ((lit->functor()*2+1) & 63);
+    unsigned char& litCnt = features[lit->isPositive() ? 0 : 1];
+    if (litCnt < 127) {
+      litCnt++;
+    }
+    NonVariableIterator nvi(lit);
+    while (nvi.hasNext()) {
+      unsigned functor = nvi.next().term()->functor();
+      signature |= 1ull << ((functor*2) & 63);
+      unsigned char& symCnt = features[2 + functor%6];
+      if (symCnt < 127) {
+        symCnt++;
+      }
+    }
+  }
+
+  _symbolSignature = signature;
+  _featureVector = 0;
+  for (unsigned i = 0; i < 8; i++) {
+    _featureVector |= static_cast<unsigned long long>(features[i]) << (i*8);
+  }
+} // Clause::computeSubsumptionFeatures
+
 
 /**
  * Return weight of the split part of the clause
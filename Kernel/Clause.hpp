@@ -176,6 +176,35 @@ public:
   }
   void computeWeight() const;
 
+  /**
+   * Return a bitmap of the symbols occurring in the clause, where every
+   * predicate and function symbol sets one of the bits. If a clause
+   * subsumes or subsumption-resolves another clause, all its bits are
+   * also set in the bitmap of the other clause.
+   */
+  unsigned long long symbolSignature() const
+  {
+    if(!_symbolSignature) {
+      computeSubsumptionFeatures();
+    }
+    return _symbolSignature;
+  }
+
+  /**
+   * Return a vector of eight byte-sized features of the clause, see
+   * computeSubsumptionFeatures(). If a clause subsumes another clause (as
+   * a multiset), none of its features is greater than the corresponding
+   * feature of the other clause.
+   */
+  unsigned long long featureVector() const
+  {
+    if(!_symbolSignature) {
+      computeSubsumptionFeatures();
+    }
+    return _featureVector;
+  }
+  void computeSubsumptionFeatures() const;
+
   /** Return the color of a clause */
   Color color() const
   {
@@ -362,6 +391,10 @@ protected:
   unsigned _age;
   /** weight */
   mutable unsigned _weight;
+  /** bitmap of the occurring symbols, or zero if not determined yet */
+  mutable unsigned long long _symbolSignature;
+  /** features for subsumption prefiltering, valid if _symbolSignature is */
+  mutable unsigned long long _featureVector;
   /** storage class */
   Store _store;
   /** in active index **/
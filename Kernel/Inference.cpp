@@ -469,6 +469,8 @@ vstring Inference::ruleName(Rule rule)
     return "instantiation";
   case MODEL_NOT_FOUND:
     return "finite model not found";
+  case IMPORTED_CLAUSE:
+    return "imported from strategy";
   default:
     ASSERTION_VIOLATION;
     return "!UNKNOWN INFERENCE RULE!";
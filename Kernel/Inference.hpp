@@ -311,6 +311,8 @@ public:
     INSTANTIATION,
     /* Finite model not found */
     MODEL_NOT_FOUND,
+    /** clause derived by another strategy and imported through clause sharing */
+    IMPORTED_CLAUSE,
   }; // class Inference::Rule
 
   explicit Inference(Rule r);
@@ -712,6 +712,9 @@ protected:
       if (hasNewSymbols(us)) {
 	newSymbolInfo = getNewSymbols("naming",us);
       }
+      else if (rule==Inference::IMPORTED_CLAUSE) {
+	newSymbolInfo = "strategy('"+us->inference()->extra()+"')";
+      }
       inferenceStr="introduced("+tptpRuleName(rule)+",["+newSymbolInfo+"])";
     }
     else {
@@ -28,8 +28,10 @@
 
 #include "Lib/Environment.hpp"
 #include "Lib/Comparison.hpp"
+#include "Lib/Hash.hpp"
 
 #include "Shell/Options.hpp"
+#include "Shell/Statistics.hpp"
 
 #include "Term.hpp"
 #include "KBO.hpp"
@@ -202,6 +204,12 @@ void KBO::State::traverse(TermList tl,int coef)
   Term* t=tl.term();
   ASSERT_VALID(*t);
 
+  if(_kbo._uniformWeights && t->shared() && t->ground()) {
+    //the weight of a ground shared term is computed when it is shared
+    _weightDiff+=t->weight()*coef;
+    return;
+  }
+
   _weightDiff+=_kbo.functionSymbolWeight(t->functor())*coef;
 
   if(!t->arity()) {
@@ -215,9 +223,14 @@ void KBO::State::traverse(TermList tl,int coef)
       stack.push(ts->next());
     }
     if(ts->isTerm()) {
-      _weightDiff+=_kbo.functionSymbolWeight(ts->term()->functor())*coef;
-      if(ts->term()->arity()) {
-	stack.push(ts->term()->args());
+      Term* st=ts->term();
+      if(_kbo._uniformWeights && st->shared() && st->ground()) {
+	_weightDiff+=st->weight()*coef;
+      } else {
+	_weightDiff+=_kbo.functionSymbolWeight(st->functor())*coef;
+	if(st->arity()) {
+	  stack.push(st->args());
+	}
       }
     } else {
       ASS_METHOD(*ts,isOrdinaryVar());
@@ -302,6 +315,12 @@ KBO::KBO(Problem& prb, const Options& opt)
 
   _variableWeight = 1;
   _defaultSymbolWeight = 1;
+  _uniformWeights = _variableWeight==1 && _defaultSymbolWeight==1 && !env.colorUsed;
+
+  _cache.ensure(1<<KBO_CACHE_BITS);
+  for(size_t i=0;i<_cache.size();i++) {
+    _cache[i].t1=0;
+  }
 
   _state=new State(this);
 }
@@ -388,6 +407,37 @@ Ordering::Result KBO::compare(TermList tl1, TermList tl2) const
   Term* t1=tl1.term();
   Term* t2=tl2.term();
 
+  env.statistics->termComparisons++;
+  if(t1->shared() && t2->shared()) {
+    //superposition and demodulation compare the same pairs of shared
+    //terms many times, so their results are cached
+    bool swapped=t2<t1;
+    if(swapped) {
+      swap(t1,t2);
+    }
+    CacheEntry& e=_cache[HashUtils::combine(PtrIdentityHash::hash(t1),
+	PtrIdentityHash::hash(t2)) & ((1<<KBO_CACHE_BITS)-1)];
+    if(e.t1==t1 && e.t2==t2) {
+      env.statistics->cachedTermComparisons++;
+      ASS_EQ(e.res, compareTerms(t1,t2));
+    } else {
+      e.t1=t1;
+      e.t2=t2;
+      e.res=compareTerms(t1,t2);
+    }
+    return swapped ? reverse(e.res) : e.res;
+  }
+  return compareTerms(t1,t2);
+}
+
+/**
+ * Compare non-variable terms @b t1 and @b t2 that are not equal.
+ */
+Ordering::Result KBO::compareTerms(Term* t1, Term* t2) const
+{
+  CALL("KBO::compareTerms");
+  ASS_NEQ(t1,t2);
+
   ASS(_state);
   State* state=_state;
 #if VDEBUG
@@ -399,8 +449,8 @@ Ordering::Result KBO::compare(TermList tl1, TermList tl2) const
   if(t1->functor()==t2->functor()) {
     state->traverse(t1,t2);
   } else {
-    state->traverse(tl1,1);
-    state->traverse(tl2,-1);
+    state->traverse(TermList(t1),1);
+    state->traverse(TermList(t2),-1);
   }
   Result res=state->result(t1,t2);
 #if VDEBUG
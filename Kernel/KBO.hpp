@@ -32,6 +32,9 @@
 
 #include "Ordering.hpp"
 
+/** Base two logarithm of the number of entries in the cache of KBO term comparisons */
+#define KBO_CACHE_BITS 14
+
 namespace Kernel {
 
 using namespace Lib;
@@ -67,6 +70,29 @@ protected:
   bool allConstantsHeavierThanVariables() const { return false; }
   bool existsZeroWeightUnaryFunction() const { return false; }
 
+  /**
+   * Entry of the cache of comparison results of shared terms. Shared
+   * terms are never destroyed, so their addresses identify them. The
+   * terms are stored so that @b t1 is at the lower address.
+   */
+  struct CacheEntry
+  {
+    Term* t1;
+    Term* t2;
+    Result res;
+  };
+
+  Result compareTerms(Term* t1, Term* t2) const;
+
+  /**
+   * True if the weight of every shared term is its Term::weight(),
+   * i.e. all symbols and variables weigh one.
+   */
+  bool _uniformWeights;
+
+  /** Direct-mapped cache of comparison results of shared terms */
+  mutable DArray<CacheEntry> _cache;
+
 
   /**
    * State used for comparing terms and literals
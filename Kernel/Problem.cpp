@@ -101,6 +101,7 @@ void Problem::initValues()
   CALL("Problem::initValues");
 
   _hadIncompleteTransformation = false;
+  _sineTheorySelector = 0;
   _mayHaveEquality = true;
   _mayHaveFormulas = true;
   _mayHaveFunctionDefinitions = true;
@@ -200,6 +201,9 @@ void Problem::copyInto(Problem& tgt, bool copyClauses)
     tgt.addUnits(UnitList::reverse(newUnits));
   }else {
     tgt.addUnits(UnitList::copy(units()));
+    //the selection structure refers to the units, so it can be used
+    //only when they are shared
+    tgt.setSineTheorySelector(sineTheorySelector());
   }
   if(hadIncompleteTransformation()) {
     tgt.reportIncompleteTransformation();
@@ -79,6 +79,14 @@ public:
   bool hadIncompleteTransformation() const { return _hadIncompleteTransformation; }
   void reportIncompleteTransformation() { _hadIncompleteTransformation = true; }
 
+  /**
+   * Set the SInE selection structure built for the theory axioms of the
+   * problem, the object is not owned by the problem
+   */
+  void setSineTheorySelector(SineTheorySelector* sel) { _sineTheorySelector = sel; }
+  /** Return the SInE selection structure for the theory axioms, or 0 */
+  SineTheorySelector* sineTheorySelector() const { return _sineTheorySelector; }
+
   typedef DHMap<unsigned,bool> TrivialPredicateMap;
   void addTrivialPredicate(unsigned pred, bool assignment);
   /**
@@ -211,6 +219,8 @@ private:
 
   bool _hadIncompleteTransformation;
 
+  SineTheorySelector* _sineTheorySelector;
+
   DHMap<unsigned,bool> _trivialPredicates;
   BDDVarMeaningMap _bddVarSpecs;
 
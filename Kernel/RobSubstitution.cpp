@@ -57,9 +57,104 @@ namespace Kernel
 using namespace std;
 using namespace Lib;
 
-const int RobSubstitution::AUX_INDEX=-3;
-const int RobSubstitution::SPECIAL_INDEX=-2;
-const int RobSubstitution::UNBOUND_INDEX=-1;
+const int RobSubstitution::AUX_INDEX;
+const int RobSubstitution::SPECIAL_INDEX;
+const int RobSubstitution::UNBOUND_INDEX;
+
+RobSubstitution::VarBanks::~VarBanks()
+{
+  CALL("RobSubstitution::VarBanks::~VarBanks");
+
+  while(_banks.isNonEmpty()) {
+    delete _banks.pop();
+  }
+}
+
+void RobSubstitution::VarBanks::set(const VarSpec& v, const TermSpec& term)
+{
+  CALL("RobSubstitution::VarBanks::set");
+  ASS_GE(v.index,AUX_INDEX);
+
+  unsigned bank=bankNumber(v.index);
+  while(bank>=_banks.size()) {
+    _banks.push(new DArray<Entry>());
+  }
+  DArray<Entry>& entries=*_banks[bank];
+  if(v.var>=entries.size()) {
+    entries.expand(v.var+1);
+  }
+  Entry& e=entries[v.var];
+  if(e.timestamp!=_timestamp) {
+    e.timestamp=_timestamp;
+    _size++;
+  }
+  e.term=term;
+}
+
+bool RobSubstitution::VarBanks::remove(const VarSpec& v)
+{
+  CALL("RobSubstitution::VarBanks::remove");
+
+  Entry* e=const_cast<Entry*>(findEntry(v));
+  if(!e) {
+    return false;
+  }
+  e->timestamp=0;
+  _size--;
+  return true;
+}
+
+/**
+ * Remove all bindings by moving to a new timestamp
+ */
+void RobSubstitution::VarBanks::reset()
+{
+  CALL("RobSubstitution::VarBanks::reset");
+
+  _size=0;
+  _timestamp++;
+  if(_timestamp!=0) {
+    return;
+  }
+  // the timestamps wrapped around, so the old ones could become valid again
+  for(unsigned b=0;b<_banks.size();b++) {
+    DArray<Entry>& entries=*_banks[b];
+    for(unsigned i=0;i<entries.size();i++) {
+      entries[i].timestamp=0;
+    }
+  }
+  _timestamp=1;
+}
+
+#if VDEBUG
+bool RobSubstitution::VarBanks::Iterator::hasNext()
+{
+  CALL("RobSubstitution::VarBanks::Iterator::hasNext");
+
+  while(_bank<_banks._banks.size()) {
+    const DArray<Entry>& entries=*_banks._banks[_bank];
+    while(_var<entries.size()) {
+      if(entries[_var].timestamp==_banks._timestamp) {
+        return true;
+      }
+      _var++;
+    }
+    _bank++;
+    _var=0;
+  }
+  return false;
+}
+
+void RobSubstitution::VarBanks::Iterator::next(VarSpec& v, TermSpec& term)
+{
+  CALL("RobSubstitution::VarBanks::Iterator::next");
+
+  ALWAYS(hasNext());
+  v=VarSpec(_var,static_cast<int>(_bank)+AUX_INDEX);
+  term=(*_banks._banks[_bank])[_var].term;
+  _var++;
+}
+#endif
 
 /**
  * Unify @b t1 and @b t2, and return true iff it was successful.
@@ -28,8 +28,10 @@
 #include <utility>
 
 #include "Forwards.hpp"
+#include "Lib/DArray.hpp"
 #include "Lib/DHMap.hpp"
 #include "Lib/Backtrackable.hpp"
+#include "Lib/Stack.hpp"
 #include "Term.hpp"
 
 #if VDEBUG
@@ -218,9 +220,9 @@ private:
   RobSubstitution& operator=(const RobSubstitution& obj);
 
 
-  static const int AUX_INDEX;
-  static const int SPECIAL_INDEX;
-  static const int UNBOUND_INDEX;
+  static const int AUX_INDEX=-3;
+  static const int SPECIAL_INDEX=-2;
+  static const int UNBOUND_INDEX=-1;
 
   bool isUnbound(VarSpec v) const;
   TermSpec deref(VarSpec v) const;
@@ -264,7 +266,79 @@ private:
   }
   static void swap(TermSpec& ts1, TermSpec& ts2);
 
-  typedef DHMap<VarSpec,TermSpec,VarSpec::Hash1, VarSpec::Hash2> BankType;
+  /**
+   * Bindings stored in one array per variable bank, indexed by the
+   * variable number. An entry is valid only if its timestamp is the
+   * current one, so the bindings are reset in constant time.
+   *
+   * Provides the part of the DHMap interface used for the bindings.
+   */
+  class VarBanks
+  {
+  public:
+    VarBanks() : _timestamp(1), _size(0) {}
+    ~VarBanks();
+
+    bool find(const VarSpec& v, TermSpec& res) const
+    {
+      const Entry* e=findEntry(v);
+      if(!e) {
+        return false;
+      }
+      res=e->term;
+      return true;
+    }
+    bool find(const VarSpec& v) const
+    {
+      return findEntry(v);
+    }
+    void set(const VarSpec& v, const TermSpec& term);
+    bool remove(const VarSpec& v);
+    void reset();
+    size_t size() const { return _size; }
+
+#if VDEBUG
+    class Iterator
+    {
+    public:
+      Iterator(const VarBanks& banks) : _banks(banks), _bank(0), _var(0) {}
+      bool hasNext();
+      void next(VarSpec& v, TermSpec& term);
+    private:
+      const VarBanks& _banks;
+      unsigned _bank;
+      unsigned _var;
+    };
+#endif
+
+  private:
+    struct Entry
+    {
+      Entry() : timestamp(0) {}
+      TermSpec term;
+      /** the entry is valid iff it equals the timestamp of the VarBanks */
+      unsigned timestamp;
+    };
+
+    /** Banks are numbered from the auxiliary one, which has the smallest index */
+    static unsigned bankNumber(int index) { return index-AUX_INDEX; }
+
+    const Entry* findEntry(const VarSpec& v) const
+    {
+      unsigned bank=bankNumber(v.index);
+      if(bank>=_banks.size() || v.var>=_banks[bank]->size()) {
+        return 0;
+      }
+      const Entry* e=&(*_banks[bank])[v.var];
+      return e->timestamp==_timestamp ? e : 0;
+    }
+
+    Stack<DArray<Entry>*> _banks;
+    unsigned _timestamp;
+    size_t _size;
+  };
+
+  typedef VarBanks BankType;
 
   mutable BankType _bank;
 
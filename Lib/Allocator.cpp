@@ -32,6 +32,7 @@
 
 #include <cstring>
 #include <cstdlib>
+#include <sys/mman.h>
 #include "Lib/System.hpp"
 #include "Shell/UIHelper.hpp"
 
@@ -584,8 +585,10 @@ Allocator::Page* Allocator::allocatePages(size_t size)
     throw Lib::MemoryLimitExceededException();
 #endif
   }
-  // check if there is a page in the list available
+  // check if there is a page in the list available, multi-pages are not
+  // kept in the lists (see deallocatePages)
   if (_pages[index]) {
+    ASS_EQ(index,0);
     result = _pages[index];
     _pages[index] = result->next;
   }
@@ -615,11 +618,23 @@ Allocator::Page* Allocator::allocatePages(size_t size)
     _usedMemory = newSize;
 
     char* mem;
-    try {
-      BYPASSING_ALLOCATOR;
-      
-      mem = new char[realSize];
-    } catch(bad_alloc) {
+    if (index) {
+      // multi-pages are seldom requested twice with the same size, so we map
+      // them directly and unmap them on deallocation, otherwise long runs
+      // would accumulate unused multi-pages of all sizes
+      void* mapped = mmap(0, realSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      mem = mapped==MAP_FAILED ? 0 : static_cast<char*>(mapped);
+    }
+    else {
+      try {
+        BYPASSING_ALLOCATOR;
+
+        mem = new char[realSize];
+      } catch(bad_alloc) {
+        mem = 0;
+      }
+    }
+    if (!mem) {
       env.beginOutput();
       reportSpiderStatus('m');
       env.out() << "Memory limit exceeded!\n";
@@ -730,8 +745,14 @@ void Allocator::deallocatePages(Page* page)
     _myPages = next;
   }
 
-  page->next = _pages[index];
-  _pages[index] = page;
+  if (index) {
+    munmap(page, size);
+    _usedMemory -= size;
+  }
+  else {
+    page->next = _pages[index];
+    _pages[index] = page;
+  }
 
 #if WATCH_ADDRESS
   unsigned addr = (unsigned)(void*)page;
@@ -300,10 +300,11 @@ private:
   /** next available known */
   char* _nextAvailableReserve;
 
-  /** Total memory allocated by pages */
+  /** Total memory allocated by pages and not returned to the OS */
   static size_t _usedMemory;
   /** Page allocator array, a.k.a. "the global manager".
-   * Each entry is a (singly linked) list */
+   * Each entry is a (singly linked) list. Only single pages are kept,
+   * deallocated multi-pages are returned to the OS */
   static Page* _pages[MAX_PAGES];
 
   friend class Initialiser;
@@ -96,6 +96,23 @@ public:
     return (set&subset)==subset;
   }
 
+  /**
+   * Return true iff each byte of @b a is less or equal to the corresponding
+   * byte of @b b. The most significant bit of every byte must be zero.
+   *
+   * All eight bytes are compared at once: setting the most significant bit
+   * of each byte of @b b before subtracting keeps borrows within the bytes,
+   * and the bit survives exactly in the bytes where @b b is not smaller.
+   */
+  static bool bytewiseLessOrEqual(unsigned long long a, unsigned long long b)
+  {
+    const unsigned long long highBits = 0x8080808080808080ull;
+    ASS_EQ(a&highBits, 0);
+    ASS_EQ(b&highBits, 0);
+
+    return (((b|highBits)-a)&highBits)==highBits;
+  }
+
   /**
    * Reverse the bit order in @b v
    */
@@ -0,0 +1,238 @@
+/*
+ * File InsertOnlySet.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file InsertOnlySet.hpp
+ * Defines class InsertOnlySet<Val,Hash> of sets that never shrink.
+ */
+
+#ifndef __InsertOnlySet__
+#define __InsertOnlySet__
+
+#include "Forwards.hpp"
+
+#include "Allocator.hpp"
+#include "Hash.hpp"
+#include "Reflection.hpp"
+
+namespace Lib {
+
+/**
+ * Set of values into which values can only be inserted, meant for
+ * hash-consing (see Indexing::TermSharing).
+ *
+ * The set is an open-addressed table with linear probing. As there is no
+ * removal, there are no deleted cells that Set has to skip, the capacity
+ * is a power of two and the probing starts at the cell given by the top
+ * bits of the Fibonacci hash of the value's hash code.
+ *
+ * Values are compared using Hash::equals, the Hash class has to contain
+ * methods Hash::hash(Val) and Hash::equals(Val,Val).
+ */
+template <typename Val,class Hash>
+class InsertOnlySet
+{
+  struct Cell
+  {
+    /** Hash code of the value, zero is reserved for empty cells */
+    unsigned code;
+    /** The value in this cell (if any) */
+    Val value;
+  };
+
+public:
+  CLASS_NAME(InsertOnlySet);
+  USE_ALLOCATOR(InsertOnlySet);
+
+  /** Create a new set */
+  InsertOnlySet()
+    : _capacity(0),
+      _bits(0),
+      _size(0),
+      _maxSize(0),
+      _entries(0)
+  {
+    CALL("InsertOnlySet::InsertOnlySet");
+    expand();
+  }
+
+  ~InsertOnlySet()
+  {
+    CALL("InsertOnlySet::~InsertOnlySet");
+
+    DEALLOC_KNOWN(_entries,_capacity*sizeof(Cell),"InsertOnlySet::Cell");
+  }
+
+  /**
+   * If a value equal to @b val is not contained in the set, insert @b val
+   * in the set.
+   * Return the value equal to @b val from the set.
+   */
+  Val insert(Val val)
+  {
+    CALL("InsertOnlySet::insert");
+
+    if (_size >= _maxSize) {
+      expand();
+    }
+    return insert(val, codeOf(Hash::hash(val)));
+  }
+
+  /**
+   * If the set contains value equal to @b key, return true,
+   * and assign the value to @b result
+   *
+   * Hash class has to contain methods
+   * Hash::hash(Key)
+   * Hash::equals(Val,Key)
+   */
+  template<typename Key>
+  bool find(Key key, Val& result) const
+  {
+    CALL("InsertOnlySet::find");
+
+    unsigned code = codeOf(Hash::hash(key));
+    for (unsigned i = firstIndex(code); _entries[i].code; i = nextIndex(i)) {
+      const Cell& cell = _entries[i];
+      if (cell.code == code && Hash::equals(cell.value,key)) {
+        result = cell.value;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /** Return the number of elements */
+  unsigned size() const { return _size; }
+
+private:
+  InsertOnlySet(const InsertOnlySet&); //private and undefined
+  InsertOnlySet& operator=(const InsertOnlySet&); //private and undefined
+
+  /** Hash code as stored in the cells, that is, non-zero */
+  static unsigned codeOf(unsigned hash)
+  {
+    return hash ? hash : 1;
+  }
+
+  unsigned firstIndex(unsigned code) const
+  {
+    return (code*2654435769u) >> (32-_bits);
+  }
+
+  unsigned nextIndex(unsigned index) const
+  {
+    return (index+1) & (_capacity-1);
+  }
+
+  /**
+   * Insert a value with a given code in the set.
+   * The set must have a sufficient capacity
+   */
+  Val insert(Val val, unsigned code)
+  {
+    unsigned i = firstIndex(code);
+    for (;;) {
+      Cell& cell = _entries[i];
+      if (!cell.code) {
+        cell.code = code;
+        cell.value = val;
+        _size++;
+        return val;
+      }
+      if (cell.code == code && Hash::equals(cell.value,val)) {
+        return cell.value;
+      }
+      i = nextIndex(i);
+    }
+  }
+
+  /** Double the capacity of the set */
+  void expand()
+  {
+    CALL("InsertOnlySet::expand");
+
+    unsigned oldCapacity = _capacity;
+    Cell* oldEntries = _entries;
+
+    _bits = _bits ? _bits+1 : 5;
+    _capacity = 1u << _bits;
+    _maxSize = _capacity/4*3;
+    void* mem = ALLOC_KNOWN(_capacity*sizeof(Cell),"InsertOnlySet::Cell");
+    _entries = static_cast<Cell*>(mem);
+    for (unsigned i = 0; i < _capacity; i++) {
+      _entries[i].code = 0;
+    }
+
+    _size = 0;
+    for (unsigned i = 0; i < oldCapacity; i++) {
+      if (oldEntries[i].code) {
+        insert(oldEntries[i].value, oldEntries[i].code);
+      }
+    }
+    if (oldEntries) {
+      DEALLOC_KNOWN(oldEntries,oldCapacity*sizeof(Cell),"InsertOnlySet::Cell");
+    }
+  }
+
+  /** Number of cells, a power of two */
+  unsigned _capacity;
+  /** Binary logarithm of @b _capacity */
+  unsigned _bits;
+  /** Number of elements */
+  unsigned _size;
+  /** Number of elements at which the set gets expanded */
+  unsigned _maxSize;
+  Cell* _entries;
+
+public:
+  /**
+   * Iterator over the values stored in the set
+   */
+  class Iterator {
+  public:
+    DECL_ELEMENT_TYPE(Val);
+
+    explicit Iterator(const InsertOnlySet& set)
+      : _next(set._entries), _last(set._entries+set._capacity) {}
+
+    bool hasNext()
+    {
+      while (_next != _last) {
+        if (_next->code) {
+          return true;
+        }
+        _next++;
+      }
+      return false;
+    }
+
+    Val next()
+    {
+      ASS(_next != _last && _next->code);
+      return (_next++)->value;
+    }
+
+  private:
+    Cell* _next;
+    Cell* _last;
+  };
+}; // class InsertOnlySet
+
+}
+
+#endif // __InsertOnlySet__
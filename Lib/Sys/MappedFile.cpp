@@ -0,0 +1,81 @@
+/**
+ * @file MappedFile.cpp
+ * Implements class MappedFile.
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "Debug/Tracer.hpp"
+
+#include "MappedFile.hpp"
+
+namespace Lib
+{
+namespace Sys
+{
+
+/**
+ * Map the file @b fileName into memory. Use isOpen() to find out
+ * whether it succeeded.
+ */
+MappedFile::MappedFile(const vstring& fileName)
+: _data(0), _size(0), _mapped(false)
+{
+  CALL("MappedFile::MappedFile");
+
+  int fd = open(fileName.c_str(), O_RDONLY);
+  if(fd==-1) {
+    return;
+  }
+  struct stat st;
+  if(fstat(fd, &st)==-1 || !S_ISREG(st.st_mode)) {
+    close(fd);
+    return;
+  }
+  _size = st.st_size;
+  if(_size==0) {
+    //an empty file cannot be mapped
+    _data = "";
+    close(fd);
+    return;
+  }
+  void* mem = mmap(0, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+  //the mapping stays valid after the descriptor is closed
+  close(fd);
+  if(mem==MAP_FAILED) {
+    _size = 0;
+    return;
+  }
+  //the file is read from the beginning to the end
+  madvise(mem, _size, MADV_SEQUENTIAL);
+  _data = static_cast<const char*>(mem);
+  _mapped = true;
+}
+
+/**
+ * Ask the system to start reading the whole file into memory in the
+ * background, so that it is already loaded when it is accessed.
+ */
+void MappedFile::prefetch()
+{
+  CALL("MappedFile::prefetch");
+
+  if(_mapped) {
+    madvise(const_cast<char*>(_data), _size, MADV_WILLNEED);
+  }
+}
+
+MappedFile::~MappedFile()
+{
+  CALL("MappedFile::~MappedFile");
+
+  if(_mapped) {
+    munmap(const_cast<char*>(_data), _size);
+  }
+}
+
+}
+}
@@ -0,0 +1,57 @@
+/**
+ * @file MappedFile.hpp
+ * Defines class MappedFile.
+ */
+
+#ifndef __MappedFile__
+#define __MappedFile__
+
+#include <cstddef>
+
+#include "Forwards.hpp"
+
+#include "Lib/Allocator.hpp"
+#include "Lib/VString.hpp"
+
+namespace Lib {
+namespace Sys {
+
+/**
+ * A read-only memory mapping of a whole file.
+ *
+ * The content can be accessed directly without copying it into a buffer.
+ * If the file cannot be mapped (it does not exist, or it is not a regular
+ * file, such as a pipe), the object is not open and the caller should
+ * fall back to reading the file through a stream.
+ */
+class MappedFile {
+public:
+  CLASS_NAME(MappedFile);
+  USE_ALLOCATOR(MappedFile);
+
+  explicit MappedFile(const vstring& fileName);
+  ~MappedFile();
+
+  /** Return true if the file was mapped successfully */
+  bool isOpen() const { return _data!=0; }
+  /** Return the content of the file, it is not null-terminated */
+  const char* data() const { return _data; }
+  /** Return the size of the file in bytes */
+  size_t size() const { return _size; }
+
+  void prefetch();
+
+private:
+  MappedFile(const MappedFile&); //private and undefined
+  const MappedFile& operator=(const MappedFile&); //private and undefined
+
+  const char* _data;
+  size_t _size;
+  /** true if _data points to a mapping that has to be unmapped */
+  bool _mapped;
+};
+
+}
+}
+
+#endif // __MappedFile__
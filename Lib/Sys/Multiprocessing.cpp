@@ -230,18 +230,35 @@ void Multiprocessing::killNoCheck(pid_t child, int signal)
   ::kill(child, signal);
 }
 
-pid_t Multiprocessing::poll_children(bool &stopped, bool &exited, int &code)
+/**
+ * Wait for a child process to stop or terminate and return its pid. A child
+ * terminated by a signal counts as exited, with the signal number increased
+ * by 256 assigned into @b code.
+ *
+ * If @b block is false and no child changed its state, return zero
+ * immediately.
+ */
+pid_t Multiprocessing::poll_children(bool &stopped, bool &exited, int &code, bool block)
 {
   CALL("Multiprocessing::poll_child");
 
   int status;
-  pid_t pid = waitpid(-1, &status, WUNTRACED);
+  pid_t pid = waitpid(-1, &status, block ? WUNTRACED : WUNTRACED | WNOHANG);
+  if(pid<=0)
+  {
+    stopped = exited = false;
+    return pid;
+  }
   stopped = WIFSTOPPED(status);
-  exited = WIFEXITED(status);
-  if(exited)
+  exited = WIFEXITED(status) || WIFSIGNALED(status);
+  if(WIFEXITED(status))
   {
     code = WEXITSTATUS(status);
   }
+  else if(WIFSIGNALED(status))
+  {
+    code = WTERMSIG(status)+256;
+  }
   return pid;
 }
 
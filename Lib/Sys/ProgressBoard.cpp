@@ -0,0 +1,127 @@
+/**
+ * @file ProgressBoard.cpp
+ * Implements class ProgressBoard.
+ */
+
+#include <cerrno>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include "Lib/Exception.hpp"
+
+#include "ProgressBoard.hpp"
+
+namespace Lib
+{
+namespace Sys
+{
+
+ProgressBoard* ProgressBoard::s_instance = 0;
+
+/**
+ * Create a board with room for @b capacity reporting processes.
+ */
+ProgressBoard::ProgressBoard(unsigned capacity)
+: _capacity(capacity), _own(0), _lock(1)
+{
+  CALL("ProgressBoard::ProgressBoard");
+  ASS_G(capacity,0);
+
+  errno=0;
+  void* mem = mmap(0, capacity*sizeof(Entry), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  if(mem==MAP_FAILED) {
+    SYSTEM_FAIL("Cannot map shared memory.",errno);
+  }
+  _entries = static_cast<Entry*>(mem);
+  for(unsigned i=0;i<capacity;i++) {
+    _entries[i].pid = 0;
+  }
+
+  _lock.set(0,1);
+}
+
+ProgressBoard::~ProgressBoard()
+{
+  CALL("ProgressBoard::~ProgressBoard");
+
+  munmap(_entries, _capacity*sizeof(Entry));
+}
+
+/**
+ * Return the entry of process @b pid, or 0 if there is none.
+ * A @b pid of zero gives a free entry.
+ */
+ProgressBoard::Entry* ProgressBoard::find(pid_t pid)
+{
+  CALL("ProgressBoard::find");
+
+  for(unsigned i=0;i<_capacity;i++) {
+    if(_entries[i].pid==pid) {
+      return &_entries[i];
+    }
+  }
+  return 0;
+}
+
+/**
+ * Publish the progress of the current process. If the board is full,
+ * the report is dropped.
+ */
+void ProgressBoard::report(unsigned activations, size_t memory)
+{
+  CALL("ProgressBoard::report");
+
+  pid_t self = getpid();
+  if(!_own || _own->pid!=self) {
+    _lock.dec(0);
+    _own = find(0);
+    if(_own) {
+      _own->activations = 0;
+      _own->memory = 0;
+      _own->pid = self;
+    }
+    _lock.inc(0);
+    if(!_own) {
+      return;
+    }
+  }
+
+  _own->activations = activations;
+  _own->memory = memory;
+}
+
+/**
+ * If process @b pid reported its progress, assign the last report
+ * into @b res and return true, otherwise return false.
+ */
+bool ProgressBoard::get(pid_t pid, Entry& res)
+{
+  CALL("ProgressBoard::get");
+  ASS_NEQ(pid,0);
+
+  Entry* e = find(pid);
+  if(!e) {
+    return false;
+  }
+  res = *e;
+  return res.pid==pid;
+}
+
+/**
+ * Free the entry of the terminated process @b pid
+ */
+void ProgressBoard::release(pid_t pid)
+{
+  CALL("ProgressBoard::release");
+  ASS_NEQ(pid,0);
+
+  _lock.dec(0);
+  Entry* e = find(pid);
+  if(e) {
+    e->pid = 0;
+  }
+  _lock.inc(0);
+}
+
+}
+}
@@ -0,0 +1,73 @@
+/**
+ * @file ProgressBoard.hpp
+ * Defines class ProgressBoard.
+ */
+
+#ifndef __ProgressBoard__
+#define __ProgressBoard__
+
+#include <sys/types.h>
+
+#include "Forwards.hpp"
+
+#include "Lib/Allocator.hpp"
+
+#include "Semaphore.hpp"
+
+namespace Lib {
+namespace Sys {
+
+/**
+ * A table in memory shared by the creating process and the processes
+ * forked from it afterwards, where the forked processes report how far
+ * they got, so that the creating process can watch them.
+ *
+ * Each reporting process claims one entry on its first report. The
+ * entry is given back by the creating process once the reporting
+ * process has terminated.
+ */
+class ProgressBoard {
+public:
+  CLASS_NAME(ProgressBoard);
+  USE_ALLOCATOR(ProgressBoard);
+
+  struct Entry {
+    /** Process owning the entry, zero if the entry is free */
+    pid_t pid;
+    /** Number of clauses activated so far */
+    unsigned activations;
+    /** Memory used in bytes */
+    size_t memory;
+  };
+
+  explicit ProgressBoard(unsigned capacity);
+  ~ProgressBoard();
+
+  void report(unsigned activations, size_t memory);
+  bool get(pid_t pid, Entry& res);
+  void release(pid_t pid);
+
+  /** Return the board of the current process, or 0 if nobody watches us */
+  static ProgressBoard* instance() { return s_instance; }
+  static void setInstance(ProgressBoard* board) { s_instance = board; }
+
+private:
+  ProgressBoard(const ProgressBoard&); //private and undefined
+  const ProgressBoard& operator=(const ProgressBoard&); //private and undefined
+
+  Entry* find(pid_t pid);
+
+  unsigned _capacity;
+  Entry* _entries;
+  /** Entry of the current process, 0 if it did not report yet */
+  Entry* _own;
+  /** Guards claiming and releasing of the entries */
+  Semaphore _lock;
+
+  static ProgressBoard* s_instance;
+};
+
+}
+}
+
+#endif // __ProgressBoard__
@@ -0,0 +1,114 @@
+/**
+ * @file SharedRing.cpp
+ * Implements class SharedRing.
+ */
+
+#include <cerrno>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include "Lib/Exception.hpp"
+
+#include "SharedRing.hpp"
+
+namespace Lib
+{
+namespace Sys
+{
+
+const unsigned SharedRing::MAX_MESSAGE_LENGTH;
+
+/**
+ * Create a ring that can hold @b capacity messages. The ring will be
+ * shared with the processes forked after this call.
+ */
+SharedRing::SharedRing(unsigned capacity)
+: _capacity(capacity), _nextRead(0), _lock(1)
+{
+  CALL("SharedRing::SharedRing");
+  ASS_G(capacity,0);
+
+  _mappedSize = sizeof(size_t) + capacity*sizeof(Slot);
+
+  errno=0;
+  void* mem = mmap(0, _mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  if(mem==MAP_FAILED) {
+    SYSTEM_FAIL("Cannot map shared memory.",errno);
+  }
+  _written = static_cast<size_t*>(mem);
+  _slots = reinterpret_cast<Slot*>(_written+1);
+  *_written = 0;
+
+  _lock.set(0,1);
+}
+
+SharedRing::~SharedRing()
+{
+  CALL("SharedRing::~SharedRing");
+
+  munmap(_written, _mappedSize);
+}
+
+/**
+ * Append message @b msg to the ring
+ */
+void SharedRing::write(const Stack<unsigned>& msg)
+{
+  CALL("SharedRing::write");
+  ASS_LE(msg.size(),MAX_MESSAGE_LENGTH);
+
+  _lock.dec(0);
+
+  size_t seq = *_written;
+  Slot& slot = _slots[seq%_capacity];
+  slot.seq = seq;
+  slot.writer = getpid();
+  slot.length = msg.size();
+  for(unsigned i=0;i<slot.length;i++) {
+    slot.data[i] = msg[i];
+  }
+  *_written = seq+1;
+
+  _lock.inc(0);
+}
+
+/**
+ * Read the next message written by another process into @b msg and
+ * return true, or return false if there is no such message.
+ */
+bool SharedRing::read(Stack<unsigned>& msg)
+{
+  CALL("SharedRing::read");
+
+  pid_t self = getpid();
+  bool found = false;
+
+  _lock.dec(0);
+
+  size_t written = *_written;
+  if(_nextRead+_capacity < written) {
+    //the oldest messages were already overwritten
+    _nextRead = written-_capacity;
+  }
+  while(_nextRead<written) {
+    const Slot& slot = _slots[_nextRead%_capacity];
+    ASS_EQ(slot.seq,_nextRead);
+    _nextRead++;
+    if(slot.writer==self) {
+      continue;
+    }
+    msg.reset();
+    for(unsigned i=0;i<slot.length;i++) {
+      msg.push(slot.data[i]);
+    }
+    found = true;
+    break;
+  }
+
+  _lock.inc(0);
+
+  return found;
+}
+
+}
+}
@@ -0,0 +1,70 @@
+/**
+ * @file SharedRing.hpp
+ * Defines class SharedRing.
+ */
+
+#ifndef __SharedRing__
+#define __SharedRing__
+
+#include <sys/types.h>
+
+#include "Forwards.hpp"
+
+#include "Lib/Allocator.hpp"
+#include "Lib/Stack.hpp"
+
+#include "Semaphore.hpp"
+
+namespace Lib {
+namespace Sys {
+
+/**
+ * A bounded ring of short messages kept in memory that is shared by the
+ * creating process and all processes forked from it afterwards.
+ *
+ * When the ring is full, the oldest messages get overwritten, so a process
+ * that reads too slowly loses some of them. Each process has its own reading
+ * position and never reads messages it wrote itself.
+ */
+class SharedRing {
+public:
+  CLASS_NAME(SharedRing);
+  USE_ALLOCATOR(SharedRing);
+
+  /** Maximal number of words in a message */
+  static const unsigned MAX_MESSAGE_LENGTH = 60;
+
+  explicit SharedRing(unsigned capacity);
+  ~SharedRing();
+
+  void write(const Stack<unsigned>& msg);
+  bool read(Stack<unsigned>& msg);
+
+private:
+  SharedRing(const SharedRing&); //private and undefined
+  const SharedRing& operator=(const SharedRing&); //private and undefined
+
+  struct Slot {
+    /** Sequence number of the message in the slot */
+    size_t seq;
+    pid_t writer;
+    unsigned length;
+    unsigned data[MAX_MESSAGE_LENGTH];
+  };
+
+  /** Number of slots */
+  unsigned _capacity;
+  size_t _mappedSize;
+  /** Number of messages ever written into the ring, lives in the shared memory */
+  size_t* _written;
+  Slot* _slots;
+  /** Sequence number of the next message this process will read */
+  size_t _nextRead;
+  /** Guards access to the shared memory */
+  Semaphore _lock;
+};
+
+}
+}
+
+#endif // __SharedRing__
@@ -39,9 +39,11 @@ using namespace Lib;
 
 bool TimeCounter::s_measuring = true;
 bool TimeCounter::s_initialized = false;
-int TimeCounter::s_measuredTimes[__TC_ELEMENT_COUNT];
-int TimeCounter::s_measuredTimesChildren[__TC_ELEMENT_COUNT];
-int TimeCounter::s_measureInitTimes[__TC_ELEMENT_COUNT];
+long long TimeCounter::s_initTicks;
+long long TimeCounter::s_initNanoseconds;
+long long TimeCounter::s_measuredTimes[__TC_ELEMENT_COUNT];
+long long TimeCounter::s_measuredTimesChildren[__TC_ELEMENT_COUNT];
+long long TimeCounter::s_measureInitTimes[__TC_ELEMENT_COUNT];
 TimeCounter* TimeCounter::s_currTop = 0;
 
 /**
@@ -57,8 +59,11 @@ void TimeCounter::reinitialize()
   s_initialized=0;
 
   initialize();
+  if(!s_measuring) {
+    return;
+  }
 
-  int currTime=env.timer->elapsedMilliseconds();
+  long long currTime=Timer::ticks();
 
   TimeCounter* counter = s_currTop;
   while(counter) {
@@ -76,8 +81,8 @@ void TimeCounter::initialize()
 
   s_initialized=true;
 
-  if(!env.options->timeStatistics()) {
-    s_measuring=false;
+  s_measuring=env.options->timeStatistics();
+  if(!s_measuring) {
     return;
   }
 
@@ -87,8 +92,29 @@ void TimeCounter::initialize()
     s_measureInitTimes[i]=-1;
   }
 
-  // OTHER is running, from time 0
-  s_measureInitTimes[TC_OTHER]=0;
+  s_initNanoseconds=Timer::monotonicNanoseconds();
+  s_initTicks=Timer::ticks();
+
+  // OTHER is running, from now on
+  s_measureInitTimes[TC_OTHER]=s_initTicks;
+}
+
+/**
+ * Convert a number of ticks to nanoseconds, taking the length of a tick
+ * from the time passed since the initialization.
+ */
+long long TimeCounter::ticksToNanoseconds(long long ticks)
+{
+#if TIMER_USE_RDTSC
+  long long elapsedTicks=Timer::ticks()-s_initTicks;
+  long long elapsedNanoseconds=Timer::monotonicNanoseconds()-s_initNanoseconds;
+  if(elapsedTicks<=0) {
+    return 0;
+  }
+  return static_cast<long long>(static_cast<double>(ticks)*elapsedNanoseconds/elapsedTicks);
+#else
+  return ticks;
+#endif
 }
 
 void TimeCounter::startMeasuring(TimeCounterUnit tcu)
@@ -109,7 +135,7 @@ void TimeCounter::startMeasuring(TimeCounterUnit tcu)
   previousTop = s_currTop;
   s_currTop = this;
 
-  int currTime=env.timer->elapsedMilliseconds();
+  long long currTime=Timer::ticks();
 
   _tcu=tcu;
   s_measureInitTimes[_tcu]=currTime;
@@ -125,8 +151,8 @@ void TimeCounter::stopMeasuring()
   }
   ASS_GE(s_measureInitTimes[_tcu], 0);
 
-  int currTime=env.timer->elapsedMilliseconds();
-  int measuredTime = currTime-s_measureInitTimes[_tcu];
+  long long currTime=Timer::ticks();
+  long long measuredTime = currTime-s_measureInitTimes[_tcu];
   s_measuredTimes[_tcu] += measuredTime;
   s_measureInitTimes[_tcu]=-1;
 
@@ -144,12 +170,12 @@ void TimeCounter::snapShot()
 {
   CALL("TimeCounter::snapShot");
 
-  int currTime=env.timer->elapsedMilliseconds();
+  long long currTime=Timer::ticks();
 
   TimeCounter* counter = s_currTop;
   while(counter) {
     ASS_GE(s_measureInitTimes[counter->_tcu], 0);
-    int measuredTime = currTime-s_measureInitTimes[counter->_tcu];
+    long long measuredTime = currTime-s_measureInitTimes[counter->_tcu];
     s_measuredTimes[counter->_tcu] += measuredTime;
     s_measureInitTimes[counter->_tcu]=currTime;
 
@@ -162,7 +188,7 @@ void TimeCounter::snapShot()
     counter = counter->previousTop;
   }
 
-  int measuredTime = currTime-s_measureInitTimes[TC_OTHER];
+  long long measuredTime = currTime-s_measureInitTimes[TC_OTHER];
   s_measuredTimes[TC_OTHER] += measuredTime;
   s_measureInitTimes[TC_OTHER]=currTime;
 }
@@ -183,7 +209,7 @@ void TimeCounter::printReport(ostream& out)
 
 void TimeCounter::outputSingleStat(TimeCounterUnit tcu, ostream& out)
 {
-  if (s_measureInitTimes[tcu]==-1 && !s_measuredTimes[tcu]) {
+  if (s_measureInitTimes[tcu]==-1 && !ticksToMilliseconds(s_measuredTimes[tcu])) {
     return;
   }
 
@@ -402,6 +428,7 @@ void TimeCounter::outputSingleStat(TimeCounterUnit tcu, ostream& out)
     break;
   case TC_NAMING:
     out << "naming";
+    break;
   case TC_LITERAL_SELECTION:
     out << "literal selection";
     break;
@@ -413,11 +440,11 @@ void TimeCounter::outputSingleStat(TimeCounterUnit tcu, ostream& out)
   }
   out<<": ";
 
-  Timer::printMSString(out, s_measuredTimes[tcu]);
+  Timer::printMSString(out, ticksToMilliseconds(s_measuredTimes[tcu]));
 
   if (s_measuredTimesChildren[tcu] > 0) {
     out << " ( own ";
-    Timer::printMSString(out, s_measuredTimes[tcu]-s_measuredTimesChildren[tcu]);
+    Timer::printMSString(out, ticksToMilliseconds(s_measuredTimes[tcu]-s_measuredTimesChildren[tcu]));
     out << " ) ";
   }
   
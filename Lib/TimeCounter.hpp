@@ -145,11 +145,22 @@ public:
 
   static void reinitialize();
 
+  /**
+   * Nanoseconds measured in @b tcu so far, not counting the block
+   * that is currently running in it.
+   */
+  static long long measuredNanoseconds(TimeCounterUnit tcu)
+  {
+    return ticksToNanoseconds(s_measuredTimes[tcu]);
+  }
+
 private:
   void startMeasuring(TimeCounterUnit tcu);
   void stopMeasuring();
 
   static void initialize();
+  static long long ticksToNanoseconds(long long ticks);
+  static int ticksToMilliseconds(long long ticks) { return static_cast<int>(ticksToNanoseconds(ticks)/1000000); }
   static void outputSingleStat(TimeCounterUnit tcu, ostream& out);
 
   /**
@@ -186,21 +197,31 @@ private:
    */
   static bool s_initialized;
   /**
-   * Contains number of milliseconds passed in each TimeCounterUnit.
+   * Values of Timer::ticks() and Timer::monotonicNanoseconds() at the
+   * initialization, used to find out the length of a tick.
+   */
+  static long long s_initTicks;
+  static long long s_initNanoseconds;
+  /**
+   * Contains number of ticks passed in each TimeCounterUnit.
+   *
+   * The times are taken from Timer::ticks() rather than from the
+   * millisecond timer, so that short blocks executed many times
+   * add up correctly instead of being rounded to zero.
    */
-  static int s_measuredTimes[];
+  static long long s_measuredTimes[];
   /**
-   * Contains number of milliseconds passed in each TimeCounterUnit's children.
+   * Contains number of ticks passed in each TimeCounterUnit's children.
    *
    * "ownTime" = "measuredTime" - "measuredTimesChildren"
    */
-  static int s_measuredTimesChildren[];
+  static long long s_measuredTimesChildren[];
   /**
    * For each TimeCounterUnit contains either -1 if the unit is not being
    * measured, or a non-negative number representing initial time of the current
    * block in the unit.
    */
-  static int s_measureInitTimes[];
+  static long long s_measureInitTimes[];
 };
 
 };
@@ -25,6 +25,7 @@
 #ifndef __Timer__
 #define __Timer__
 
+#include <ctime>
 #include <iostream>
 
 #include "Debug/Assertion.hpp"
@@ -48,6 +49,18 @@
 #endif
 #endif
 
+#ifndef TIMER_USE_RDTSC
+#if defined(__x86_64__) || defined(__i386__)
+#define TIMER_USE_RDTSC 1
+#else
+#define TIMER_USE_RDTSC 0
+#endif
+#endif
+
+#if TIMER_USE_RDTSC
+#include <x86intrin.h>
+#endif
+
 namespace Lib
 {
 
@@ -129,6 +142,37 @@ public:
 
   static void syncClock();
 
+  /**
+   * Nanoseconds of a monotonic wall clock since an unspecified moment.
+   *
+   * Unlike the millisecond counter ticked by SIGALRM, this reads no shared
+   * state and can be called from any thread. On Linux clock_gettime is
+   * served from the vDSO, so a call costs tens of nanoseconds.
+   */
+  static long long monotonicNanoseconds()
+  {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<long long>(ts.tv_sec)*1000000000LL + ts.tv_nsec;
+  }
+
+  /**
+   * A monotonic tick count that is cheaper to read than monotonicNanoseconds().
+   *
+   * With TIMER_USE_RDTSC this is the processor's time stamp counter, otherwise
+   * the ticks are nanoseconds. The length of a tick is not known, differences
+   * of ticks are converted to time by comparing them with monotonicNanoseconds()
+   * over a long enough interval (see TimeCounter).
+   */
+  static long long ticks()
+  {
+#if TIMER_USE_RDTSC
+    return static_cast<long long>(__rdtsc());
+#else
+    return monotonicNanoseconds();
+#endif
+  }
+
   static bool s_timeLimitEnforcement;
 private:
   /** true if the timer must account for the time spent in
@@ -23,6 +23,7 @@
  * @since 08/04/2011 Manchester
  */
 
+#include <cstring>
 #include <fstream>
 
 #include "Debug/Assertion.hpp"
@@ -30,6 +31,7 @@
 
 #include "Lib/Int.hpp"
 #include "Lib/Environment.hpp"
+#include "Lib/ScopedPtr.hpp"
 
 #include "Kernel/Signature.hpp"
 #include "Kernel/Inference.hpp"
@@ -81,7 +83,12 @@ UnitList* TPTP::parse(istream& input)
 TPTP::TPTP(istream& in)
   : _containsConjecture(false),
     _allowedNames(0),
+    _usedIncludes(false),
+    _usedVampireDirectives(false),
     _in(&in),
+    _mem(0),
+    _memLength(0),
+    _memPos(0),
     _includeDirectory(""),
     _currentColor(COLOR_TRANSPARENT),
     _modelDefinition(false),
@@ -93,11 +100,43 @@ TPTP::TPTP(istream& in)
 } // TPTP::TPTP
 
 /**
- * The destructor, does nothing.
+ * Initialise a lexer reading @b length characters directly from @b chars,
+ * for example from a memory mapped file, without copying them into a buffer.
+ * Files included by the input are mapped into memory as well.
+ */
+TPTP::TPTP(const char* chars, size_t length)
+  : _containsConjecture(false),
+    _allowedNames(0),
+    _usedIncludes(false),
+    _usedVampireDirectives(false),
+    _in(0),
+    _mem(chars),
+    _memLength(length),
+    _memPos(0),
+    _includeDirectory(""),
+    _currentColor(COLOR_TRANSPARENT),
+    _modelDefinition(false),
+    _insideEqualityArgument(0),
+    _unitSources(0),
+    _filterReserved(false),
+    _seenConjecture(false)
+{
+} // TPTP::TPTP
+
+/**
+ * The destructor, releases the files mapped by include() if parsing
+ * did not finish.
  * @since 09/07/2012 Manchester
  */
 TPTP::~TPTP()
 {
+  while (_mappedIncludes.isNonEmpty()) {
+    delete _mappedIncludes.pop();
+  }
+  DHMap<vstring,Sys::MappedFile*>::Iterator pit(_prefetchedIncludes);
+  while (pit.hasNext()) {
+    delete pit.next();
+  }
 } // TPTP::~TPTP
 
 /**
@@ -113,6 +152,9 @@ void TPTP::parse()
   _cend = 0;
   _tend = 0;
   _lineNumber = 1;
+  if (!_in) {
+    prefetchIncludes();
+  }
   _states.push(UNIT_LIST);
   while (!_states.isEmpty()) {
     State s = _states.pop();
@@ -803,8 +845,8 @@ void TPTP::readName(Token& tok)
     case '9':
       break;
     default:
-      ASS(_chars.content()[0] != '$');
-      tok.content.assign(_chars.content(),n);
+      ASS(input()[0] != '$');
+      tok.content.assign(input(),n);
       shiftChars(n);
       return;
     }
@@ -888,7 +930,7 @@ void TPTP::readReserved(Token& tok)
     case '9':
       break;
     default:
-      tok.content.assign(_chars.content(),n);
+      tok.content.assign(input(),n);
       //shiftChars(n);
       goto out;
     }
@@ -960,7 +1002,7 @@ void TPTP::readReserved(Token& tok)
           for(;;c++){ if(getChar(c)!='$') break;}
           shiftChars(c);
           n=n-c;
-          tok.content.assign(_chars.content(),n);
+          tok.content.assign(input(),n);
       }
       
       tok.tag = T_NAME;
@@ -989,7 +1031,7 @@ void TPTP::readString(Token& tok)
       continue;
     }
     if (c == '"') {
-      tok.content.assign(_chars.content()+1,n-1);
+      tok.content.assign(input()+1,n-1);
       resetChars();
       return;
     }
@@ -1017,7 +1059,7 @@ void TPTP::readAtom(Token& tok)
       continue;
     }
     if (c == '\'') {
-      tok.content.assign(_chars.content()+1,n-1);
+      tok.content.assign(input()+1,n-1);
       resetChars();
       return;
     }
@@ -1059,7 +1101,7 @@ TPTP::Tag TPTP::readNumber(Token& tok)
   switch (getChar(pos)) {
   case '/':
     pos = positiveDecimal(pos+1);
-    tok.content.assign(_chars.content(),pos);
+    tok.content.assign(input(),pos);
     shiftChars(pos);
     return T_RAT;
   case 'E':
@@ -1067,7 +1109,7 @@ TPTP::Tag TPTP::readNumber(Token& tok)
     {
       char c = getChar(pos+1);
       pos = decimal((c == '+' || c == '-') ? pos+2 : pos+1);
-      tok.content.assign(_chars.content(),pos);
+      tok.content.assign(input(),pos);
       shiftChars(pos);
     }
     return T_REAL;
@@ -1087,12 +1129,12 @@ TPTP::Tag TPTP::readNumber(Token& tok)
 	c = getChar(pos+1);
 	pos = decimal((c == '+' || c == '-') ? pos+2 : pos+1);
       }
-      tok.content.assign(_chars.content(),pos);
+      tok.content.assign(input(),pos);
       shiftChars(pos);
     }
     return T_REAL;
   default:
-    tok.content.assign(_chars.content(),pos);
+    tok.content.assign(input(),pos);
     shiftChars(pos);
     return T_INT;
   }
@@ -1188,10 +1230,17 @@ void TPTP::unitList()
       return;
     }
     resetChars();
-    {
+    if (_in) {
       BYPASSING_ALLOCATOR; // ifstream was allocated by "system new"
       delete _in;
     }
+    else {
+      delete _mappedIncludes.pop();
+      MemInput prev = _memInputs.pop();
+      _mem = prev.chars;
+      _memLength = prev.length;
+      _memPos = prev.pos;
+    }
     _in = _inputs.pop();
     _includeDirectory = _includeDirectories.pop();
     delete _allowedNames;
@@ -1610,10 +1659,29 @@ void TPTP::include()
   if (ignore) {
     return;
   }
+  _usedIncludes = true;
   // here should be a computation of the new include directory according to
   // the TPTP standard, so far we just set it to ""
   _includeDirectory = "";
   vstring fileName(env.options->includeFileName(relativeName));
+  if (!_in) {
+    Sys::MappedFile* prefetched;
+    ScopedPtr<Sys::MappedFile> file(_prefetchedIncludes.pop(fileName,prefetched) ?
+        prefetched : new Sys::MappedFile(fileName));
+    if (!file->isOpen()) {
+      USER_ERROR((vstring)"cannot open file " + fileName);
+    }
+    ASS_EQ(_cend,0);
+    MemInput prev = { _mem, _memLength, _memPos };
+    _memInputs.push(prev);
+    _mappedIncludes.push(file.ptr());
+    _mem = file->data();
+    _memLength = file->size();
+    _memPos = 0;
+    //from now on the file is deleted when its end is reached
+    file.release();
+    return;
+  }
   {
     BYPASSING_ALLOCATOR; // we cannot make ifstream allocated via Allocator
     _in = new ifstream(fileName.c_str());
@@ -1623,6 +1691,66 @@ void TPTP::include()
   }
 } // include
 
+/**
+ * Map into memory the files of the include() directives at the beginning
+ * of the input and let the system read them all in the background, so that
+ * the disk reads overlap with parsing instead of happening one file after
+ * another when include() reaches them.
+ *
+ * Only the leading directives, preceded by nothing but whitespace and
+ * comment lines, are considered. This covers the usual problem layout
+ * without scanning the whole input.
+ */
+void TPTP::prefetchIncludes()
+{
+  CALL("TPTP::prefetchIncludes");
+  ASS(!_in);
+
+  static const char* directive = "include('";
+  static const size_t directiveLength = strlen(directive);
+
+  size_t pos = 0;
+  while (pos < _memLength) {
+    char c = _mem[pos];
+    if (c == ' ' || c == '\t' || c == '\r' || c == '\n') {
+      pos++;
+      continue;
+    }
+    if (c == '%') {
+      while (pos < _memLength && _mem[pos] != '\n') {
+        pos++;
+      }
+      continue;
+    }
+    if (_memLength-pos <= directiveLength || strncmp(_mem+pos,directive,directiveLength)) {
+      return;
+    }
+    pos += directiveLength;
+    size_t start = pos;
+    while (pos < _memLength && _mem[pos] != '\'' && _mem[pos] != '\n') {
+      pos++;
+    }
+    if (pos == _memLength || _mem[pos] != '\'') {
+      return;
+    }
+    vstring relativeName(_mem+start,pos-start);
+    if (!_forbiddenIncludes.contains(relativeName)) {
+      vstring fileName(env.options->includeFileName(relativeName));
+      if (!_prefetchedIncludes.find(fileName)) {
+        ScopedPtr<Sys::MappedFile> file(new Sys::MappedFile(fileName));
+        file->prefetch();
+        _prefetchedIncludes.insert(fileName,file.ptr());
+        //from now on the file is deleted together with the parser
+        file.release();
+      }
+    }
+    //skip the rest of the directive
+    while (pos < _memLength && _mem[pos] != '\n') {
+      pos++;
+    }
+  }
+} // prefetchIncludes
+
 /** add a file name to the list of forbidden includes */
 void TPTP::addForbiddenInclude(vstring file)
 {
@@ -1983,9 +2111,13 @@ void TPTP::endTupleBinding() {
   }
 } // endTupleBinding
 
-bool TPTP::findLetSymbol(bool isPredicate, vstring name, unsigned arity, unsigned& symbol) {
+bool TPTP::findLetSymbol(bool isPredicate, const vstring& name, unsigned arity, unsigned& symbol) {
   CALL("TPTP::findLetSymbol");
 
+  if (_letScopes.isEmpty()) {
+    return false;
+  }
+
   LetFunctionName functionName(name, arity);
 
   Stack<LetFunctionsScope>::TopFirstIterator scopes(_letScopes);
@@ -3986,6 +4118,8 @@ void TPTP::vampire()
 {
   CALL("TPTP::vampire");
 
+  _usedVampireDirectives = true;
+
   consumeToken(T_LPAR);
   vstring nm = name();
 
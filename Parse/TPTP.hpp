@@ -29,10 +29,12 @@
 #include <iostream>
 
 #include "Lib/Array.hpp"
+#include "Lib/DHMap.hpp"
 #include "Lib/Set.hpp"
 #include "Lib/Stack.hpp"
 #include "Lib/Exception.hpp"
 #include "Lib/IntNameTable.hpp"
+#include "Lib/Sys/MappedFile.hpp"
 
 #include "Kernel/Formula.hpp"
 #include "Kernel/Unit.hpp"
@@ -59,6 +61,9 @@ class TPTP;
 class TPTP 
 {
 public:
+  CLASS_NAME(TPTP);
+  USE_ALLOCATOR(TPTP);
+
   /** Token types */
   enum Tag {
     /** end of file */
@@ -296,6 +301,7 @@ public:
   throw ParseErrorException(msg,tok,_lineNumber)
 
   TPTP(istream& in);
+  TPTP(const char* chars, size_t length);
   ~TPTP();
   void parse();
   static UnitList* parse(istream& str);
@@ -309,14 +315,18 @@ public:
    * based on this value.
    */
   bool containsConjecture() const { return _containsConjecture; }
+  /** Return true if the input included other files */
+  bool usedIncludes() const { return _usedIncludes; }
+  /** Return true if the input contained vampire() directives */
+  bool usedVampireDirectives() const { return _usedVampireDirectives; }
   void addForbiddenInclude(vstring file);
   static bool findAxiomName(const Unit* unit, vstring& result);
   //this function is used also by the API
   static void assignAxiomName(const Unit* unit, vstring& name);
   unsigned lineNumber(){ return _lineNumber; }
 private:
-  /** Return the input string of characters */
-  const char* input() { return _chars.content(); }
+  /** Return the input string of characters, starting at the 0th character of the window */
+  const char* input() { return _in ? _chars.content() : _mem+_memPos; }
 
   enum TypeTag {
     TT_ATOMIC,
@@ -506,10 +516,32 @@ private:
   Stack<Set<vstring>*> _allowedNamesStack;
   /** set of files whose inclusion should be ignored */
   Set<vstring> _forbiddenIncludes;
-  /** the input stream */
+  /** true if include() read some file */
+  bool _usedIncludes;
+  /** true if a vampire() directive was read, these change options and symbols */
+  bool _usedVampireDirectives;
+  /** the input stream, 0 if the input is read directly from memory */
   istream* _in;
   /** in the case include() is used, previous streams will be saved here */
   Stack<istream*> _inputs;
+  /** the input characters if the input is read directly from memory */
+  const char* _mem;
+  /** number of the input characters in _mem */
+  size_t _memLength;
+  /** position in _mem of the 0th character of the window */
+  size_t _memPos;
+  /** an input in memory saved by include() */
+  struct MemInput {
+    const char* chars;
+    size_t length;
+    size_t pos;
+  };
+  /** in the case include() is used with the input in memory, previous inputs will be saved here */
+  Stack<MemInput> _memInputs;
+  /** files mapped into memory by include(), the top one is being read */
+  Stack<Sys::MappedFile*> _mappedIncludes;
+  /** files of the leading include() directives mapped in advance by prefetchIncludes() */
+  DHMap<vstring,Sys::MappedFile*> _prefetchedIncludes;
   /** the current include directory */
   vstring _includeDirectory;
   /** in the case include() is used, previous sequence of directories will be
@@ -588,7 +620,7 @@ private:
   /** a stack of scopes */
   Stack<LetFunctionsScope> _letScopes;
   /** finds if the symbol has been defined in an enclosing $let */
-  bool findLetSymbol(bool isPredicate, vstring name, unsigned arity, unsigned& symbol);
+  bool findLetSymbol(bool isPredicate, const vstring& name, unsigned arity, unsigned& symbol);
   /** the scope of the currently parsed $let-term */
   LetFunctionsScope _currentLetScope;
 
@@ -611,6 +643,13 @@ private:
   {
     CALL("TPTP::getChar");
 
+    if (!_in) {
+      if (_cend <= pos) {
+        _cend = pos+1;
+      }
+      size_t mpos = _memPos+pos;
+      return mpos < _memLength ? _mem[mpos] : 0;
+    }
     while (_cend <= pos) {
       int c = _in->get();
       //      if (c == -1) { cout << "<EOF>"; } else {cout << char(c);}
@@ -628,8 +667,13 @@ private:
     ASS(n > 0);
     ASS(n <= _cend);
 
-    for (int i = 0;i < _cend-n;i++) {
-      _chars[i] = _chars[n+i];
+    if (_in) {
+      for (int i = 0;i < _cend-n;i++) {
+        _chars[i] = _chars[n+i];
+      }
+    }
+    else {
+      _memPos += n;
     }
     _cend -= n;
     _gpos += n;
@@ -641,6 +685,7 @@ private:
    */
   inline void resetChars()
   {
+    _memPos += _cend;
     _gpos += _cend;
     _cend = 0;
   } // resetChars
@@ -730,6 +775,7 @@ private:
   void endFof();
   void endTff();
   void include();
+  void prefetchIncludes();
   void type();
   void endIte();
   void binding();
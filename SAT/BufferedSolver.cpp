@@ -130,13 +130,16 @@ SATSolver::Status BufferedSolver::solve(unsigned conflictCountLimit)
 {
   CALL("BufferedSolver::solve"); 
   
-  // BufferedSolver does not support "UNKNOWN" status as
-  // it needs _inner to have either a model or to be provably unsat
-  ASS_EQ(conflictCountLimit, UINT_MAX);
-  
   if (_lastStatus == UNSATISFIABLE) {
     return UNSATISFIABLE;
   }
+
+  // the buffer can only be checked against a model of _inner,
+  // after an unfinished search we let _inner continue it
+  if (_lastStatus == UNKNOWN) {
+    flushUnadded();
+    return (_lastStatus = _inner->solve(conflictCountLimit));
+  }
   
   ASS_EQ(_lastStatus,SATISFIABLE);
   
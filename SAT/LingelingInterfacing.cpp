@@ -0,0 +1,217 @@
+
+/*
+ * File LingelingInterfacing.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file LingelingInterfacing.cpp
+ * Implements class LingelingInterfacing
+ */
+
+#include "LingelingInterfacing.hpp"
+
+namespace SAT
+{
+
+using namespace Shell;
+using namespace Lib;
+
+LingelingInterfacing::LingelingInterfacing(const Shell::Options& opts, bool generateProofs):
+  _status(SATISFIABLE), _varCnt(0)
+{
+  CALL("LingelingInterfacing::LingelingInterfacing");
+
+  _solver = lglinit();
+  // no messages on stdout
+  lglsetopt(_solver, "verbose", -1);
+}
+
+LingelingInterfacing::~LingelingInterfacing()
+{
+  CALL("LingelingInterfacing::~LingelingInterfacing");
+
+  lglrelease(_solver);
+}
+
+/**
+ * Make the solver handle clauses with variables up to @b newVarCnt
+ */
+void LingelingInterfacing::ensureVarCount(unsigned newVarCnt)
+{
+  CALL("LingelingInterfacing::ensureVarCount");
+
+  while(_varCnt < newVarCnt) {
+    newVar();
+  }
+}
+
+unsigned LingelingInterfacing::newVar()
+{
+  CALL("LingelingInterfacing::newVar");
+
+  _varCnt++;
+  lglfreeze(_solver, (int)_varCnt);
+  return _varCnt;
+}
+
+void LingelingInterfacing::suggestPolarity(unsigned var, unsigned pol)
+{
+  CALL("LingelingInterfacing::suggestPolarity");
+  ASS_G(var,0); ASS_LE(var,_varCnt);
+
+  lglsetphase(_solver, pol ? (int)var : -(int)var);
+}
+
+void LingelingInterfacing::addAssumption(SATLiteral lit)
+{
+  CALL("LingelingInterfacing::addAssumption");
+
+  _assumptions.push(lit);
+}
+
+SATSolver::Status LingelingInterfacing::solveUnderAssumptions(const SATLiteralStack& assumps, unsigned conflictCountLimit, bool)
+{
+  CALL("LingelingInterfacing::solveUnderAssumptions");
+
+  ASS(!hasAssumptions());
+
+  _assumptions.loadFromIterator(SATLiteralStack::ConstIterator(assumps));
+
+  solveModuloAssumptionsAndSetStatus(conflictCountLimit);
+
+  if (_status == SATSolver::UNSATISFIABLE) {
+    // collect the assumptions lingeling used in the refutation
+    _failedAssumptionBuffer.reset();
+    SATLiteralStack::Iterator it(_assumptions);
+    while (it.hasNext()) {
+      SATLiteral lit = it.next();
+      if (lglfailed(_solver, vampireLit2Lingeling(lit))) {
+        _failedAssumptionBuffer.push(lit);
+      }
+    }
+  }
+
+  _assumptions.reset();
+
+  return _status;
+}
+
+/**
+ * Solve modulo assumptions and set status.
+ *
+ * Lingeling forgets the assumptions after each call to lglsat,
+ * so they are passed again every time.
+ */
+void LingelingInterfacing::solveModuloAssumptionsAndSetStatus(unsigned conflictCountLimit)
+{
+  CALL("LingelingInterfacing::solveModuloAssumptionsAndSetStatus");
+
+  // the conflict limit is relative to the conflicts of the previous calls
+  int clim = (conflictCountLimit > (unsigned)INT_MAX) ? -1 : (int)conflictCountLimit;
+  lglsetopt(_solver, "clim", clim);
+
+  SATLiteralStack::Iterator it(_assumptions);
+  while (it.hasNext()) {
+    lglassume(_solver, vampireLit2Lingeling(it.next()));
+  }
+
+  int res = lglsat(_solver);
+
+  if (res == LGL_SATISFIABLE) {
+    _status = SATISFIABLE;
+  } else if (res == LGL_UNSATISFIABLE) {
+    _status = UNSATISFIABLE;
+  } else {
+    _status = UNKNOWN;
+  }
+}
+
+/**
+ * Add clause into the solver.
+ */
+void LingelingInterfacing::addClause(SATClause* cl)
+{
+  CALL("LingelingInterfacing::addClause");
+
+  // store to later generate the refutation
+  PrimitiveProofRecordingSATSolver::addClause(cl);
+
+  ASS(!hasAssumptions());
+
+  unsigned clen=cl->length();
+  for(unsigned i=0;i<clen;i++) {
+    lgladd(_solver, vampireLit2Lingeling((*cl)[i]));
+  }
+  lgladd(_solver, 0);
+}
+
+/**
+ * Perform solving and return status.
+ */
+SATSolver::Status LingelingInterfacing::solve(unsigned conflictCountLimit)
+{
+  CALL("LingelingInterfacing::solve");
+
+  solveModuloAssumptionsAndSetStatus(conflictCountLimit);
+  return _status;
+}
+
+SATSolver::VarAssignment LingelingInterfacing::getAssignment(unsigned var)
+{
+  CALL("LingelingInterfacing::getAssignment");
+  ASS_EQ(_status, SATISFIABLE);
+  ASS_G(var,0); ASS_LE(var,_varCnt);
+
+  int res = lglderef(_solver, (int)var);
+  if (res > 0) {
+    return TRUE;
+  } else if (res < 0) {
+    return FALSE;
+  } else {
+    return DONT_CARE;
+  }
+}
+
+bool LingelingInterfacing::isZeroImplied(unsigned var)
+{
+  CALL("LingelingInterfacing::isZeroImplied");
+  ASS_G(var,0); ASS_LE(var,_varCnt);
+
+  return lglfixed(_solver, (int)var) != 0;
+}
+
+void LingelingInterfacing::collectZeroImplied(SATLiteralStack& acc)
+{
+  CALL("LingelingInterfacing::collectZeroImplied");
+
+  for (unsigned var = 1; var <= _varCnt; var++) {
+    int val = lglfixed(_solver, (int)var);
+    if (val) {
+      acc.push(SATLiteral(var, val > 0 ? 1 : 0));
+    }
+  }
+}
+
+SATClause* LingelingInterfacing::getZeroImpliedCertificate(unsigned)
+{
+  CALL("LingelingInterfacing::getZeroImpliedCertificate");
+
+  // Currently unused anyway, see MinisatInterfacing.
+
+  return 0;
+}
+
+}//end SAT namespace
@@ -0,0 +1,133 @@
+
+/*
+ * File LingelingInterfacing.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file LingelingInterfacing.hpp
+ * Defines class LingelingInterfacing
+ */
+#ifndef __LingelingInterfacing__
+#define __LingelingInterfacing__
+
+#include "SATSolver.hpp"
+#include "SATLiteral.hpp"
+#include "SATClause.hpp"
+
+extern "C" {
+#include "lglib.h"
+}
+
+namespace SAT{
+
+/**
+ * Incremental interface to the lingeling SAT solver.
+ *
+ * Every variable is frozen as soon as it is allocated, so that
+ * lingeling never eliminates a variable that a later clause or
+ * assumption may mention.
+ */
+class LingelingInterfacing : public PrimitiveProofRecordingSATSolver
+{
+public:
+  CLASS_NAME(LingelingInterfacing);
+  USE_ALLOCATOR(LingelingInterfacing);
+
+  LingelingInterfacing(const Shell::Options& opts, bool generateProofs=false);
+  ~LingelingInterfacing();
+
+  /**
+   * Can be called only when all assumptions are retracted
+   *
+   * A requirement is that in a clause, each variable occurs at most once.
+   */
+  virtual void addClause(SATClause* cl) override;
+
+  virtual Status solve(unsigned conflictCountLimit) override;
+
+  /**
+   * If status is @c SATISFIABLE, return assignment of variable @c var
+   */
+  virtual VarAssignment getAssignment(unsigned var) override;
+
+  /**
+   * Return true if the assignment of @c var is implied
+   * on the top level (i.e. does not depend on any decisions or assumptions)
+   */
+  virtual bool isZeroImplied(unsigned var) override;
+  /**
+   * Collect zero-implied literals.
+   *
+   * Can be used in SATISFIABLE and UNKNOWN state.
+   *
+   * @see isZeroImplied()
+   */
+  virtual void collectZeroImplied(SATLiteralStack& acc) override;
+  /**
+   * Lingeling does not produce certificates, 0 is always returned.
+   */
+  virtual SATClause* getZeroImpliedCertificate(unsigned var) override;
+
+  virtual void ensureVarCount(unsigned newVarCnt) override;
+
+  virtual unsigned newVar() override;
+
+  virtual void suggestPolarity(unsigned var, unsigned pol) override;
+
+  /**
+   * Add an assumption into the solver.
+   */
+  virtual void addAssumption(SATLiteral lit) override;
+
+  virtual void retractAllAssumptions() override {
+    _assumptions.reset();
+    _status = UNKNOWN;
+  };
+
+  virtual bool hasAssumptions() const override {
+    return _assumptions.isNonEmpty();
+  };
+
+ /**
+  * Record the association between a SATLiteral var and a Literal
+  * In TWLSolver this is used for computing niceness values
+  */
+  virtual void recordSource(unsigned satlitvar, Literal* lit) override {
+    // unsupported by lingeling; intentionally no-op
+  };
+
+  Status solveUnderAssumptions(const SATLiteralStack& assumps, unsigned conflictCountLimit, bool) override;
+
+protected:
+  void solveModuloAssumptionsAndSetStatus(unsigned conflictCountLimit = UINT_MAX);
+
+  /* lingeling's variables start from 1 as well, negative literals are negated integers */
+  int vampireLit2Lingeling(SATLiteral vlit) {
+    ASS_G(vlit.var(),0); ASS_LE(vlit.var(),_varCnt);
+    return vlit.polarity() ? (int)vlit.var() : -(int)vlit.var();
+  }
+
+private:
+  Status _status;
+  /** Number of variables allocated (and frozen) so far */
+  unsigned _varCnt;
+  SATLiteralStack _assumptions;
+  LGL* _solver;
+};
+
+}//end SAT namespace
+
+#endif /*LingelingInterfacing*/
@@ -0,0 +1,250 @@
+/*
+ * File ClauseSharing.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file ClauseSharing.cpp
+ * Implements class ClauseSharing.
+ */
+
+#include "Lib/Environment.hpp"
+#include "Lib/SharedSet.hpp"
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/Inference.hpp"
+#include "Kernel/Signature.hpp"
+#include "Kernel/SortHelper.hpp"
+#include "Kernel/Sorts.hpp"
+
+#include "Shell/Statistics.hpp"
+
+#include "ClauseSharing.hpp"
+
+/** Number of messages the shared ring can hold */
+#define CLAUSE_SHARING_CAPACITY 8192
+
+namespace Saturation
+{
+
+using namespace Lib;
+using namespace Kernel;
+using namespace Shell;
+
+ClauseSharing* ClauseSharing::s_instance = 0;
+
+/**
+ * Create the channel for the strategies given by their codes in
+ * @b strategies
+ */
+ClauseSharing::ClauseSharing(const Stack<vstring>& strategies)
+: _strategies(strategies),
+  _strategy(0),
+  _functions(env.signature->functions()),
+  _predicates(env.signature->predicates()),
+  _sorts(env.sorts->count()),
+  _ring(CLAUSE_SHARING_CAPACITY)
+{
+  ASS(strategies.isNonEmpty());
+}
+
+/**
+ * Set the strategy run by the current process to the one with the
+ * code @b strategy. Called in the strategy after it is forked.
+ */
+void ClauseSharing::setStrategy(const vstring& strategy)
+{
+  CALL("ClauseSharing::setStrategy");
+
+  for (unsigned i=0; i<_strategies.size(); i++) {
+    if (_strategies[i]==strategy) {
+      _strategy = i;
+      return;
+    }
+  }
+  ASSERTION_VIOLATION;
+}
+
+/**
+ * Return true if @b cl is worth sending to the other strategies
+ * and is meaningful for them.
+ *
+ * We only share derived unit and ground clauses. Clauses that depend
+ * on AVATAR assertions are not valid for the other strategies, and the
+ * clauses we imported ourselves would only go back to where they came from.
+ */
+bool ClauseSharing::isShareable(Clause* cl)
+{
+  CALL("ClauseSharing::isShareable");
+
+  if (cl->age()==0 || cl->inference()->rule()==Inference::IMPORTED_CLAUSE) {
+    return false;
+  }
+  if (cl->splits() && !cl->splits()->isEmpty()) {
+    return false;
+  }
+  if (cl->color()!=COLOR_TRANSPARENT) {
+    return false;
+  }
+  return cl->length()<=1 || cl->isGround();
+}
+
+/**
+ * Send @b cl to the other strategies, if it is shareable and
+ * small enough
+ */
+void ClauseSharing::publish(Clause* cl)
+{
+  CALL("ClauseSharing::publish");
+
+  if (!isShareable(cl)) {
+    return;
+  }
+
+  _msg.reset();
+  _msg.push(_strategy);
+  _msg.push(cl->inputType());
+  _msg.push(cl->length());
+  for (unsigned i=0; i<cl->length(); i++) {
+    Literal* lit = (*cl)[i];
+    if (lit->functor()>=_predicates) {
+      return;
+    }
+    _msg.push((lit->functor()<<1) | (lit->isPositive() ? 1 : 0));
+    if (lit->isEquality()) {
+      unsigned sort = SortHelper::getEqualityArgumentSort(lit);
+      if (sort>=_sorts) {
+        return;
+      }
+      _msg.push(sort);
+    }
+    for (TermList* arg=lit->args(); arg->isNonEmpty(); arg=arg->next()) {
+      if (!serialize(*arg)) {
+        return;
+      }
+    }
+  }
+  if (_msg.size()>Sys::SharedRing::MAX_MESSAGE_LENGTH) {
+    return;
+  }
+
+  _ring.write(_msg);
+  env.statistics->exportedSharedClauses++;
+}
+
+/**
+ * Append the encoding of @b t to the message buffer. Return false if
+ * the term cannot be shared or the message got too long.
+ *
+ * Variables are encoded as odd numbers and function symbols as even ones,
+ * the arguments of a function symbol follow the symbol.
+ */
+bool ClauseSharing::serialize(TermList t)
+{
+  CALL("ClauseSharing::serialize");
+
+  if (_msg.size()>=Sys::SharedRing::MAX_MESSAGE_LENGTH) {
+    return false;
+  }
+  if (t.isVar()) {
+    if (!t.isOrdinaryVar()) {
+      return false;
+    }
+    _msg.push((t.var()<<1) | 1);
+    return true;
+  }
+  Term* trm = t.term();
+  if (trm->isSpecial() || trm->functor()>=_functions) {
+    return false;
+  }
+  _msg.push(trm->functor()<<1);
+  for (TermList* arg=trm->args(); arg->isNonEmpty(); arg=arg->next()) {
+    if (!serialize(*arg)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Decode the term starting at position @b pos of the message buffer
+ * and move @b pos after it.
+ */
+TermList ClauseSharing::deserialize(unsigned& pos)
+{
+  CALL("ClauseSharing::deserialize");
+
+  unsigned code = _msg[pos++];
+  if (code & 1) {
+    return TermList(code>>1, false);
+  }
+  unsigned functor = code>>1;
+  ASS_L(functor,_functions);
+  unsigned arity = env.signature->functionArity(functor);
+  Stack<TermList> args(arity);
+  for (unsigned i=0; i<arity; i++) {
+    args.push(deserialize(pos));
+  }
+  return TermList(Term::create(functor, arity, args.begin()));
+}
+
+/**
+ * Return the next clause sent by another strategy, or zero if
+ * there is none.
+ */
+Clause* ClauseSharing::readClause()
+{
+  CALL("ClauseSharing::readClause");
+
+  if (!_ring.read(_msg)) {
+    return 0;
+  }
+
+  unsigned pos = 0;
+  unsigned strategy = _msg[pos++];
+  ASS_L(strategy,_strategies.size());
+  Unit::InputType inputType = static_cast<Unit::InputType>(_msg[pos++]);
+  unsigned length = _msg[pos++];
+
+  _lits.reset();
+  for (unsigned i=0; i<length; i++) {
+    unsigned header = _msg[pos++];
+    unsigned pred = header>>1;
+    bool polarity = header & 1;
+    ASS_L(pred,_predicates);
+    if (pred==0) {
+      unsigned sort = _msg[pos++];
+      ASS_L(sort,_sorts);
+      TermList lhs = deserialize(pos);
+      TermList rhs = deserialize(pos);
+      _lits.push(Literal::createEquality(polarity, lhs, rhs, sort));
+      continue;
+    }
+    unsigned arity = env.signature->predicateArity(pred);
+    Stack<TermList> args(arity);
+    for (unsigned j=0; j<arity; j++) {
+      args.push(deserialize(pos));
+    }
+    _lits.push(Literal::create(pred, arity, polarity, false, args.begin()));
+  }
+  ASS_EQ(pos,_msg.size());
+
+  env.statistics->importedSharedClauses++;
+  Inference* inf = new Inference(Inference::IMPORTED_CLAUSE);
+  inf->setExtra(_strategies[strategy]);
+  return Clause::fromStack(_lits, inputType, inf);
+}
+
+}
@@ -0,0 +1,95 @@
+/*
+ * File ClauseSharing.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file ClauseSharing.hpp
+ * Defines class ClauseSharing.
+ */
+
+#ifndef __ClauseSharing__
+#define __ClauseSharing__
+
+#include "Forwards.hpp"
+
+#include "Lib/Stack.hpp"
+#include "Lib/Sys/SharedRing.hpp"
+
+#include "Kernel/Term.hpp"
+
+namespace Saturation {
+
+using namespace Lib;
+using namespace Kernel;
+
+/**
+ * Channel through which strategies forked from the same preprocessed
+ * problem exchange short derived clauses.
+ *
+ * The object is created in the process holding the preprocessed problem
+ * before the strategies are forked. Only clauses over the symbols and sorts
+ * that existed at that point are exchanged, since the ones introduced later
+ * differ from strategy to strategy.
+ *
+ * Each message carries the index of the sending strategy in the schedule
+ * of the group, so that the proofs can name the strategy an imported
+ * clause comes from.
+ */
+class ClauseSharing {
+public:
+  CLASS_NAME(ClauseSharing);
+  USE_ALLOCATOR(ClauseSharing);
+
+  ClauseSharing(const Stack<vstring>& strategies);
+
+  void setStrategy(const vstring& strategy);
+
+  void publish(Clause* cl);
+  Clause* readClause();
+
+  /** Return the object shared by the current process, or zero if there is none */
+  static ClauseSharing* instance() { return s_instance; }
+  static void setInstance(ClauseSharing* inst) { s_instance = inst; }
+
+private:
+  bool isShareable(Clause* cl);
+  bool serialize(TermList t);
+  TermList deserialize(unsigned& pos);
+
+  /** Codes of the strategies of the group */
+  Stack<vstring> _strategies;
+  /** Index of the current process's strategy in @b _strategies */
+  unsigned _strategy;
+
+  /** Number of function symbols that all the strategies agree on */
+  unsigned _functions;
+  /** Number of predicate symbols that all the strategies agree on */
+  unsigned _predicates;
+  /** Number of sorts that all the strategies agree on */
+  unsigned _sorts;
+
+  Sys::SharedRing _ring;
+  /** Buffer for the message being written or read */
+  Stack<unsigned> _msg;
+  /** Buffer for the literals of the clause being read */
+  Stack<Literal*> _lits;
+
+  static ClauseSharing* s_instance;
+};
+
+}
+
+#endif // __ClauseSharing__
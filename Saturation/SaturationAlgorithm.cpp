@@ -31,6 +31,7 @@
 #include "Lib/Timer.hpp"
 #include "Lib/VirtualIterator.hpp"
 #include "Lib/System.hpp"
+#include "Lib/Sys/ProgressBoard.hpp"
 
 #include "Indexing/LiteralIndexingStructure.hpp"
 
@@ -79,6 +80,7 @@
 
 #include "Splitter.hpp"
 
+#include "ClauseSharing.hpp"
 #include "ConsequenceFinder.hpp"
 #include "LabelFinder.hpp"
 #include "Splitter.hpp"
@@ -102,6 +104,9 @@ using namespace Saturation;
 #define REPORT_BW_SIMPL 0
 
 
+/** Number of main loop iterations between imports of shared clauses */
+#define CLAUSE_SHARING_IMPORT_INTERVAL 16
+
 SaturationAlgorithm* SaturationAlgorithm::s_instance = 0;
 
 /**
@@ -116,7 +121,7 @@ SaturationAlgorithm::SaturationAlgorithm(Problem& prb, const Options& opt)
     _clauseActivationInProgress(false),
     _fwSimplifiers(0), _bwSimplifiers(0), _splitter(0),
     _consFinder(0), _labelFinder(0), _symEl(0), _answerLiteralManager(0),
-    _instantiation(0),
+    _instantiation(0), _clauseSharing(0), _progressBoard(0),
 #if VZ3
     _theoryInstSimp(0),
 #endif
@@ -164,6 +169,11 @@ SaturationAlgorithm::SaturationAlgorithm(Problem& prb, const Options& opt)
     _limits.setLimits(0,opt.maxWeight());
   }
 
+  if (opt.clauseSharing()) {
+    _clauseSharing = ClauseSharing::instance();
+  }
+  _progressBoard = Sys::ProgressBoard::instance();
+
   s_instance=this;
 }
 
@@ -1026,6 +1036,9 @@ bool SaturationAlgorithm::activate(Clause* cl)
   env.statistics->activeClauses++;
   _active->add(cl);
 
+  if (_clauseSharing) {
+    _clauseSharing->publish(cl);
+  }
 
     ClauseIterator toAdd= pvi(getConcatenatedIterator(instances,_generator->generateClauses(cl)));
 
@@ -1193,6 +1206,20 @@ void SaturationAlgorithm::doOneAlgorithmStep()
 }
 
 
+/**
+ * Add the clauses that other strategies sent through the clause
+ * sharing channel since the last call.
+ */
+void SaturationAlgorithm::importSharedClauses()
+{
+  CALL("SaturationAlgorithm::importSharedClauses");
+  ASS(_clauseSharing);
+
+  while (Clause* cl = _clauseSharing->readClause()) {
+    addNewClause(cl);
+  }
+}
+
 /**
  * Perform saturation on clauses that were added through
  * @b addInputClauses function
@@ -1209,6 +1236,13 @@ MainLoopResult SaturationAlgorithm::runImpl()
         throw ActivationLimitExceededException();
       }
 
+      if (_clauseSharing && l%CLAUSE_SHARING_IMPORT_INTERVAL==0) {
+        importSharedClauses();
+      }
+      if (_progressBoard) {
+        _progressBoard->report(env.statistics->activeClauses, Allocator::getUsedMemory());
+      }
+
       doOneAlgorithmStep();
 
       Timer::syncClock();
@@ -166,6 +166,7 @@ private:
   void passiveRemovedHandler(Clause* cl);
   void activeRemovedHandler(Clause* cl);
   void addInputClause(Clause* cl);
+  void importSharedClauses();
 
   LiteralSelector& getSosLiteralSelector();
 
@@ -213,6 +214,9 @@ protected:
   SymElOutput* _symEl;
   AnswerLiteralManager* _answerLiteralManager;
   Instantiation* _instantiation;
+  ClauseSharing* _clauseSharing;
+  /** Where we report our progress to the portfolio scheduler, if it watches us */
+  Lib::Sys::ProgressBoard* _progressBoard;
 #if VZ3
   TheoryInstAndSimp* _theoryInstSimp;
 #endif
@@ -52,6 +52,7 @@
 #include "SAT/BufferedSolver.hpp"
 #include "SAT/FallbackSolverWrapper.hpp"
 #include "SAT/MinisatInterfacing.hpp"
+#include "SAT/LingelingInterfacing.hpp"
 #include "SAT/Z3Interfacing.hpp"
 
 #include "DP/ShortConflictMetaDP.hpp"
@@ -83,6 +84,9 @@ void SplittingBranchSelector::init()
     case Options::SatSolver::MINISAT:
       _solver = new MinisatInterfacing(_parent.getOptions(),true);
       break;      
+    case Options::SatSolver::LINGELING:
+      _solver = new LingelingInterfacing(_parent.getOptions(),true);
+      break;
 #if VZ3
     case Options::SatSolver::Z3:
       { BYPASSING_ALLOCATOR
@@ -116,6 +120,15 @@ void SplittingBranchSelector::init()
   }
   _minSCO = _parent.getOptions().splittingMinimizeModel() == Options::SplittingMinimizeModel::SCO;
 
+  _conflictBudget = _parent.getOptions().splittingConflictBudget();
+#if VZ3
+  // Z3 reports UNKNOWN also when it gives up, so it is never given a budget
+  if (_parent.getOptions().satSolver() == Options::SatSolver::Z3) {
+    _conflictBudget = 0;
+  }
+#endif
+  _currentBudget = _conflictBudget;
+
   if(_parent.getOptions().splittingCongruenceClosure() != Options::SplittingCongruenceClosure::OFF) {
     _dp = new DP::SimpleCongruenceClosure(&_parent.getOrdering());
     if (_parent.getOptions().ccUnsatCores() == Options::CCUnsatCores::SMALL_ONES) {
@@ -394,6 +407,45 @@ int SplittingBranchSelector::assertedGroundPositiveEqualityCompomentMaxAge()
   return max;
 }
 
+/**
+ * Make @c dp contain exactly the literals of @c assignment.
+ *
+ * Each literal is added in its own backtracking level and @c asserted
+ * keeps them in the order of the levels. Only the levels from the lowest
+ * literal that is no longer in the assignment up are popped, so the
+ * decision procedure does work only for the literals that changed.
+ */
+void SplittingBranchSelector::updateDPAssignment(DecisionProcedure& dp, LiteralStack& asserted,
+    const LiteralStack& assignment, bool onlyEqualities)
+{
+  CALL("SplittingBranchSelector::updateDPAssignment");
+
+  static DHSet<Literal*> toAssert;
+  toAssert.reset();
+  toAssert.loadFromIterator(LiteralStack::ConstIterator(assignment));
+
+  unsigned kept = 0;
+  while(kept<asserted.size() && toAssert.remove(asserted[kept])) {
+    kept++;
+  }
+  if(kept<asserted.size()) {
+    dp.pop(asserted.size()-kept);
+    asserted.truncate(kept);
+  }
+  RSTAT_CTR_INC_MANY("ssat_dp_kept_literals",kept);
+
+  LiteralStack::ConstIterator ait(assignment);
+  while(ait.hasNext()) {
+    Literal* lit = ait.next();
+    if(!toAssert.contains(lit)) {
+      continue;
+    }
+    dp.push();
+    dp.addLiterals(pvi(getSingletonIterator(lit)), onlyEqualities);
+    asserted.push(lit);
+  }
+}
+
 SATSolver::Status SplittingBranchSelector::processDPConflicts()
 {
   CALL("SplittingBranchSelector::processDPConflicts");
@@ -416,8 +468,7 @@ SATSolver::Status SplittingBranchSelector::processDPConflicts()
       s2f.collectAssignment(*_solver, gndAssignment); 
       // ... moreover, _dp->addLiterals will filter the set anyway
 
-      _dp->reset();
-      _dp->addLiterals(pvi( LiteralStack::ConstIterator(gndAssignment) ));
+      updateDPAssignment(*_dp, _dpAsserted, gndAssignment, false);
       DecisionProcedure::Status dpStatus = _dp->getStatus(_ccMultipleCores);
 
       if(dpStatus!=DecisionProcedure::UNSATISFIABLE) {
@@ -464,8 +515,7 @@ SATSolver::Status SplittingBranchSelector::processDPConflicts()
     static LiteralStack model;
     model.reset();
 
-    _dpModel->reset();
-    _dpModel->addLiterals(pvi( LiteralStack::ConstIterator(gndAssignment) ),true /*only equalities now*/);
+    updateDPAssignment(*_dpModel, _dpModelAsserted, gndAssignment, true /*only equalities now*/);
     ALWAYS(_dpModel->getStatus(false) == DecisionProcedure::SATISFIABLE);
     _dpModel->getModel(model);
 
@@ -588,13 +638,23 @@ void SplittingBranchSelector::addSatClauseToSolver(SATClause* cl, bool branchRef
   }
 }
 
-void SplittingBranchSelector::recomputeModel(SplitLevelStack& addedComps, SplitLevelStack& removedComps, bool randomize)
+/**
+ * Recompute the SAT model and report the components that became selected and deselected.
+ *
+ * If @b mayPostpone is true and the option avatar_conflict_budget is set, the SAT solver
+ * stops after the current budget of conflicts. The selection is then left as it is,
+ * the update is remembered as pending and the search is resumed by the next call
+ * with a doubled budget. The solver keeps its learned clauses between the calls.
+ */
+void SplittingBranchSelector::recomputeModel(SplitLevelStack& addedComps, SplitLevelStack& removedComps, bool randomize,
+    bool mayPostpone)
 {
   CALL("SplittingBranchSelector::recomputeModel");
   ASS(addedComps.isEmpty());
   ASS(removedComps.isEmpty());
 
   unsigned maxSatVar = _parent.maxSatVar();
+  unsigned conflictLimit = (mayPostpone && _conflictBudget) ? _currentBudget : UINT_MAX;
   
   SATSolver::Status stat;
   {
@@ -602,8 +662,17 @@ void SplittingBranchSelector::recomputeModel(SplitLevelStack& addedComps, SplitL
     if (randomize) {
       _solver->randomizeForNextAssignment(maxSatVar);
     }
-    stat = _solver->solve();
+    stat = _solver->solve(conflictLimit);
+  }
+  if (stat == SATSolver::UNKNOWN && conflictLimit != UINT_MAX) {
+    env.statistics->splittingPostponedModelUpdates++;
+    _modelUpdatePending = true;
+    _currentBudget = (_currentBudget > UINT_MAX/2) ? UINT_MAX-1 : 2*_currentBudget;
+    return;
   }
+  _modelUpdatePending = false;
+  _currentBudget = _conflictBudget;
+
   if (stat == SATSolver::SATISFIABLE) {
     stat = processDPConflicts();
   }
@@ -786,19 +855,24 @@ void Splitter::onAllProcessed()
     }
   }
 
+  bool hadRefutation = _haveBranchRefutation;
   _haveBranchRefutation = false;
-  if(!_clausesAdded && !flushing) {
+  if(!_clausesAdded && !flushing && !_branchSelector.modelUpdatePending()) {
     return;
   }
   _clausesAdded = false;
 
+  // a postponed update must be finished before the saturation can conclude,
+  // and the current selection must not be kept once it has been refuted
+  bool mayPostpone = !hadRefutation && _sa->passiveClauseCount()!=0;
+
   static SplitLevelStack toAdd;
   static SplitLevelStack toRemove;
   
   toAdd.reset();
   toRemove.reset();  
 
-  _branchSelector.recomputeModel(toAdd, toRemove, flushing);
+  _branchSelector.recomputeModel(toAdd, toRemove, flushing, mayPostpone);
   
   if (_showSplitting) { // TODO: this is just one of many ways Splitter could report about changes
     env.beginOutput();
@@ -65,7 +65,8 @@ class Splitter;
  */
 class SplittingBranchSelector {
 public:
-  SplittingBranchSelector(Splitter& parent) : _ccModel(false), _parent(parent)  {}
+  SplittingBranchSelector(Splitter& parent) : _ccModel(false), _conflictBudget(0), _currentBudget(0),
+    _modelUpdatePending(false), _parent(parent)  {}
   ~SplittingBranchSelector(){
 #if VZ3
 {
@@ -82,12 +83,17 @@ _solver=0;
   void considerPolarityAdvice(SATLiteral lit);
 
   void addSatClauseToSolver(SATClause* cl, bool refutation);
-  void recomputeModel(SplitLevelStack& addedComps, SplitLevelStack& removedComps, bool randomize = false);
+  void recomputeModel(SplitLevelStack& addedComps, SplitLevelStack& removedComps, bool randomize = false,
+      bool mayPostpone = false);
+  /** True if the last model update ran out of its conflict budget and was postponed */
+  bool modelUpdatePending() const { return _modelUpdatePending; }
 
   void flush(SplitLevelStack& addedComps, SplitLevelStack& removedComps);
 
 private:
   SATSolver::Status processDPConflicts();
+  static void updateDPAssignment(DecisionProcedure& dp, LiteralStack& asserted,
+      const LiteralStack& assignment, bool onlyEqualities);
   SATSolver::VarAssignment getSolverAssimentConsideringCCModel(unsigned var);
 
   void handleSatRefutation();
@@ -102,6 +108,13 @@ private:
   bool _ccMultipleCores;
   bool _minSCO; // minimize wrt splitting clauses only
   bool _ccModel;
+  /** Conflict budget of a postponable model update, zero if updates are never postponed */
+  unsigned _conflictBudget;
+
+  /** Budget of the next postponable update, grows while the updates stay unfinished */
+  unsigned _currentBudget;
+  /** The SAT solver has clauses that the current selection need not satisfy */
+  bool _modelUpdatePending;
 
   Splitter& _parent;
 
@@ -109,6 +122,12 @@ private:
   ScopedPtr<DecisionProcedure> _dp;
   // use a separate copy of the decision procedure for ccModel computations and fill it up only with equalities
   ScopedPtr<SimpleCongruenceClosure> _dpModel;
+  /**
+   * Literals asserted in _dp and _dpModel, in the order of their
+   * backtracking levels (one level per literal)
+   */
+  LiteralStack _dpAsserted;
+  LiteralStack _dpModelAsserted;
   
   /**
    * Contains selected component names (splitlevels)
@@ -125,11 +125,12 @@ void NewCNF::clausify(FormulaUnit* unit,Stack<Clause*>& output)
   _freeVars.reset();
 
   { // destroy the cached substitution entries
-    DHMap<BindingList*,Substitution*>::DelIterator dIt(_substitutionsByBindings);
-    while (dIt.hasNext()) {
-      delete dIt.next();
-      dIt.del();
+    Stack<Substitution*>::Iterator sIt(_substitutionsToDestroy);
+    while (sIt.hasNext()) {
+      delete sIt.next();
     }
+    _substitutionsToDestroy.reset();
+    _substitutionsByBindings.reset();
   }
 
   ASS(_queue.isEmpty());
@@ -950,6 +951,8 @@ void NewCNF::skolemise(QuantifiedFormula* g, BindingList*& bindings, BindingList
       // store the results in the caches
       _skolemsByFreeVars.insert(unboundFreeVars, processedBindings);
       _foolSkolemsByFreeVars.insert(unboundFreeVars, processedFoolBindings);
+      _skolemBindingsToDestroy.push(processedBindings);
+      _skolemBindingsToDestroy.push(processedFoolBindings);
     }
 
     _skolemsByBindings.insert(bindings, processedBindings);
@@ -994,24 +997,15 @@ void NewCNF::process(QuantifiedFormula* g, Occurrences &occurrences)
 
   // empty the skolem caches
   _skolemsByBindings.reset();
-  DHMap<VarSet*,BindingList*>::DelIterator dIt(_skolemsByFreeVars);
-  while (dIt.hasNext()) {
-    VarSet* vars;
-    BindingList* bindings;
-    dIt.next(vars,bindings);
-    BindingList::destroy(bindings);
-    dIt.del();
-  }
-
+  _skolemsByFreeVars.reset();
   _foolSkolemsByBindings.reset();
-  DHMap<VarSet*,BindingList*>::DelIterator fdit(_foolSkolemsByFreeVars);
-  while (fdit.hasNext()) {
-    VarSet* vars;
-    BindingList* bindings;
-    fdit.next(vars, bindings);
-    BindingList::destroy(bindings);
-    fdit.del();
+  _foolSkolemsByFreeVars.reset();
+
+  Stack<BindingList*>::Iterator bit(_skolemBindingsToDestroy);
+  while (bit.hasNext()) {
+    BindingList::destroy(bit.next());
   }
+  _skolemBindingsToDestroy.reset();
 
   // Note that the formula under quantifier reuses the quantified formula's occurrences
   enqueue(g->qarg(), occurrences);
@@ -1384,6 +1378,7 @@ Clause* NewCNF::toClause(SPGenClause gc)
       subst->bind(b.first, b.second);
     }
     _substitutionsByBindings.insert(gc->bindings, subst);
+    _substitutionsToDestroy.push(subst);
   }
 
   static Stack<Literal*> properLiterals;
@@ -595,9 +595,15 @@ private:
   DHMap<BindingList*,BindingList*> _foolSkolemsByBindings;
   DHMap<VarSet*,BindingList*>      _foolSkolemsByFreeVars;
 
+  // the values stored in the two maps above, so that emptying the caches
+  // does not need to traverse the (never shrinking) maps
+  Stack<BindingList*> _skolemBindingsToDestroy;
+
   // caching binding substitutions for the final phase of GenClause -> Clause transformation
   // this saves time, because bindings are potentially shared
   DHMap<BindingList*,Substitution*> _substitutionsByBindings;
+  // the values of _substitutionsByBindings, for the same reason as above
+  Stack<Substitution*> _substitutionsToDestroy;
 
   void skolemise(QuantifiedFormula* g, BindingList* &bindings, BindingList*& foolBindings);
 
@@ -186,6 +186,30 @@ void Options::Options::init()
         Or(_mode.is(equal(Mode::SMTCOMP)))->
         Or(_mode.is(equal(Mode::PORTFOLIO)))));
 
+    _sharedPreprocessing = BoolOptionValue("shared_preprocessing","",false);
+    _sharedPreprocessing.description = "When running in portfolio mode, preprocess the problem once for every group of strategies with the same preprocessing options and fork the strategies from the preprocessed problem";
+    _lookup.insert(&_sharedPreprocessing);
+    _sharedPreprocessing.reliesOnHard(_mode.is(equal(Mode::CASC)->
+        Or(_mode.is(equal(Mode::CASC_SAT)))->
+        Or(_mode.is(equal(Mode::SMTCOMP)))->
+        Or(_mode.is(equal(Mode::PORTFOLIO)))));
+    _sharedPreprocessing.setExperimental();
+
+    _clauseSharing = BoolOptionValue("clause_sharing","",false);
+    _clauseSharing.description = "Let the strategies forked from the same preprocessed problem exchange derived unit and ground clauses";
+    _lookup.insert(&_clauseSharing);
+    _clauseSharing.reliesOn(_sharedPreprocessing.is(equal(true)));
+    _clauseSharing.setExperimental();
+
+    _dynamicScheduling = BoolOptionValue("dynamic_scheduling","",false);
+    _dynamicScheduling.description = "When running in portfolio mode, terminate the strategies that stopped making progress so that the waiting ones can start earlier";
+    _lookup.insert(&_dynamicScheduling);
+    _dynamicScheduling.reliesOnHard(_mode.is(equal(Mode::CASC)->
+        Or(_mode.is(equal(Mode::CASC_SAT)))->
+        Or(_mode.is(equal(Mode::SMTCOMP)))->
+        Or(_mode.is(equal(Mode::PORTFOLIO)))));
+    _dynamicScheduling.setExperimental();
+
     _ltbLearning = ChoiceOptionValue<LTBLearning>("ltb_learning","ltbl",LTBLearning::OFF,{"on","off","biased"});
     _ltbLearning.description = "Perform learning in LTB mode";
     _lookup.insert(&_ltbLearning);
@@ -360,6 +384,13 @@ void Options::Options::init()
     _lookup.insert(&_inputSyntax);
     _inputSyntax.tag(OptionTag::INPUT);
 
+    _problemCache = StringOptionValue("problem_cache","","");
+    _problemCache.description="Directory for binary caches of parsed TPTP files. A file whose cache is found there"
+      " is loaded from the cache instead of being parsed, otherwise the cache is created after parsing";
+    _lookup.insert(&_problemCache);
+    _problemCache.tag(OptionTag::INPUT);
+    _problemCache.setExperimental();
+
     _smtlibConsiderIntsReal = BoolOptionValue("smtlib_consider_ints_real","",false);
     _smtlibConsiderIntsReal.description="all integers will be considered to be reals by the SMTLIB parser";
     _lookup.insert(&_smtlibConsiderIntsReal);
@@ -571,6 +602,14 @@ void Options::Options::init()
     _latexUseDefaultSymbols.tag(OptionTag::OUTPUT);
     _lookup.insert(&_latexUseDefaultSymbols);
 
+    _preprocessingReport = StringOptionValue("preprocessing_report","","");
+    _preprocessingReport.description="File that will contain a JSON report with the time, the numbers of formulas"
+        " and clauses before and after, and the change of used memory of each preprocessing pass."
+        " The file is rewritten after every pass, so it also shows how far preprocessing got when it does not finish."
+        " In the portfolio modes every process writes its own report, into the file name followed by a dot and the process id.";
+    _lookup.insert(&_preprocessingReport);
+    _preprocessingReport.tag(OptionTag::OUTPUT);
+
     _outputAxiomNames = BoolOptionValue("output_axiom_names","",false);
     _outputAxiomNames.description="Preserve names of axioms from the problem file in the proof output";
     _lookup.insert(&_outputAxiomNames);
@@ -1308,6 +1347,18 @@ void Options::Options::init()
     _splittingBufferedSolver.reliesOn(_splitting.is(equal(true)));
     _splittingBufferedSolver.setRandomChoices({"on","off"});
 
+    _splittingConflictBudget = UnsignedOptionValue("avatar_conflict_budget","acb",0);
+    _splittingConflictBudget.description=
+    "if non-zero, a model update may spend at most this many SAT solver conflicts. If the solver does not finish, saturation continues under the previous model and the search is resumed at the next update with a doubled budget. The search is always finished before saturation can conclude. If equal to zero, the model is always recomputed in full.";
+    _lookup.insert(&_splittingConflictBudget);
+    _splittingConflictBudget.tag(OptionTag::AVATAR);
+    _splittingConflictBudget.setExperimental();
+    _splittingConflictBudget.reliesOn(_splitting.is(equal(true)));
+#if VZ3
+    _splittingConflictBudget.reliesOn(_satSolver.is(notEqual(SatSolver::Z3)));
+#endif
+    _splittingConflictBudget.setRandomChoices({"0","0","100","1000","10000"});
+
     _splittingDeleteDeactivated = ChoiceOptionValue<SplittingDeleteDeactivated>("avatar_delete_deactivated","add",
                                                                         SplittingDeleteDeactivated::ON,{"on","large","off"});
 
@@ -1438,12 +1489,12 @@ void Options::Options::init()
 
     _satSolver = ChoiceOptionValue<SatSolver>("sat_solver","sas",SatSolver::MINISAT,
 #if VZ3
-            {"minisat","vampire","z3"});
+            {"minisat","vampire","z3","lingeling"});
 #else
-    {"minisat","vampire"});
+    {"minisat","vampire","lingeling"});
 #endif
     _satSolver.description=
-    "Select the SAT solver to be used throughout the solver. This will be used in AVATAR (for splitting) when the saturation algorithm is discount,lrs or otter and in instance generation for selection and global subsumption.";
+    "Select the SAT solver to be used throughout the solver. This will be used in AVATAR (for splitting) when the saturation algorithm is discount,lrs or otter and in instance generation for selection and global subsumption. The finite model builder uses lingeling if it is selected and minisat otherwise.";
     _lookup.insert(&_satSolver);
     _satSolver.tag(OptionTag::SAT);
     _satSolver.setRandomChoices(
@@ -2789,6 +2840,49 @@ vstring Options::generateEncodedOptions() const
 }
 
 
+/**
+ * Return a string that identifies the values of all options that can
+ * influence preprocessing. Two option objects with the same fingerprint
+ * yield the same preprocessed problem, so strategies with the same
+ * fingerprint may share it (see the shared_preprocessing option).
+ */
+vstring Options::preprocessingFingerprint() const
+{
+  CALL("Options::preprocessingFingerprint");
+
+  BYPASSING_ALLOCATOR;
+
+  vostringstream res;
+  VirtualIterator<AbstractOptionValue*> options = _lookup.values();
+  while(options.hasNext()){
+    AbstractOptionValue* option = options.next();
+    if(option->getTag()!=OptionTag::PREPROCESSING || option->isDefault()){
+      continue;
+    }
+    res << option->longName << "=" << option->getStringOfActual() << ":";
+  }
+
+  // options not tagged as preprocessing ones which are nevertheless
+  // read during preprocessing or by the property scan of the preprocessed
+  // problem (equivalentVariableRemoval is not even in _lookup)
+  const AbstractOptionValue* extra[] = {
+    &_questionAnswering,
+    &_termAlgebraCyclicityCheck,
+    &_FOOLParamodulation,
+    &_equivalentVariableRemoval,
+    &_saturationAlgorithm,
+    &_bfnt,
+    &_symbolPrecedence
+  };
+  for(const AbstractOptionValue* option : extra){
+    if(option->isDefault()){
+      continue;
+    }
+    res << option->longName << "=" << option->getStringOfActual() << ":";
+  }
+  return res.str();
+}
+
 /**
  * True if the options are complete.
  * @since 23/07/2011 Manchester
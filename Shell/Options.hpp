@@ -139,6 +139,7 @@ public:
     void readFromEncodedOptions (vstring testId);
     void readOptionsString (vstring testId,bool assign=true);
     vstring generateEncodedOptions() const;
+    vstring preprocessingFingerprint() const;
 
     // deal with completeness
     bool complete(const Problem&) const;
@@ -470,9 +471,12 @@ public:
   /** Possible values for sat_solver */
   enum class SatSolver : unsigned int {
      MINISAT = 0,
-     VAMPIRE = 1
+     VAMPIRE = 1,
 #if VZ3
-     ,Z3 = 2
+     Z3 = 2,
+     LINGELING = 3
+#else
+     LINGELING = 2
 #endif
   };
 
@@ -1803,6 +1807,9 @@ public:
   void setSchedule(Schedule newVal) {  _schedule.actualValue = newVal; }
   unsigned multicore() const { return _multicore.actualValue; }
   void setMulticore(unsigned newVal) { _multicore.actualValue = newVal; }
+  bool sharedPreprocessing() const { return _sharedPreprocessing.actualValue; }
+  bool clauseSharing() const { return _clauseSharing.actualValue; }
+  bool dynamicScheduling() const { return _dynamicScheduling.actualValue; }
   InputSyntax inputSyntax() const { return _inputSyntax.actualValue; }
   void setInputSyntax(InputSyntax newVal) { _inputSyntax.actualValue = newVal; }
   bool normalize() const { return _normalize.actualValue; }
@@ -1812,6 +1819,7 @@ public:
   void setInclude(vstring val) { _include.actualValue = val; }
   vstring logFile() const { return _logFile.actualValue; }
   vstring inputFile() const { return _inputFile.actualValue; }
+  vstring problemCache() const { return _problemCache.actualValue; }
   int activationLimit() const { return _activationLimit.actualValue; }
   int randomSeed() const { return _randomSeed.actualValue; }
   int rowVariableMaxLength() const { return _rowVariableMaxLength.actualValue; }
@@ -1869,6 +1877,7 @@ public:
   int selection() const { return _selection.actualValue; }
   void setSelection(int v) { _selection.actualValue=v;}
   vstring latexOutput() const { return _latexOutput.actualValue; }
+  vstring preprocessingReport() const { return _preprocessingReport.actualValue; }
   bool latexUseDefault() const { return _latexUseDefaultSymbols.actualValue; }
   LiteralComparisonMode literalComparisonMode() const { return _literalComparisonMode.actualValue; }
   bool forwardSubsumptionResolution() const { return _forwardSubsumptionResolution.actualValue; }
@@ -2016,6 +2025,7 @@ public:
   SplittingDeleteDeactivated splittingDeleteDeactivated() const { return _splittingDeleteDeactivated.actualValue;}
   bool splittingFastRestart() const { return _splittingFastRestart.actualValue; }
   bool splittingBufferedSolver() const { return _splittingBufferedSolver.actualValue; }
+  unsigned splittingConflictBudget() const { return _splittingConflictBudget.actualValue; }
   int splittingFlushPeriod() const { return _splittingFlushPeriod.actualValue; }
   float splittingFlushQuotient() const { return _splittingFlushQuotient.actualValue; }
   bool splittingEagerRemoval() const { return _splittingEagerRemoval.actualValue; }
@@ -2246,6 +2256,7 @@ private:
   BoolOptionValue _interpretedSimplification;
 
   StringOptionValue _latexOutput;
+  StringOptionValue _preprocessingReport;
   BoolOptionValue _latexUseDefaultSymbols;
 
   ChoiceOptionValue<LiteralComparisonMode> _literalComparisonMode;
@@ -2266,6 +2277,9 @@ private:
   ChoiceOptionValue<Mode> _mode;
   ChoiceOptionValue<Schedule> _schedule;
   UnsignedOptionValue _multicore;
+  BoolOptionValue _sharedPreprocessing;
+  BoolOptionValue _clauseSharing;
+  BoolOptionValue _dynamicScheduling;
 
   StringOptionValue _namePrefix;
   IntOptionValue _naming;
@@ -2276,6 +2290,7 @@ private:
   BoolOptionValue _outputAxiomNames;
 
   BoolOptionValue _printClausifierPremises;
+  StringOptionValue _problemCache;
   StringOptionValue _problemName;
   ChoiceOptionValue<Proof> _proof;
   ChoiceOptionValue<ProofExtra> _proofExtra;
@@ -2359,6 +2374,7 @@ private:
   ChoiceOptionValue<SplittingDeleteDeactivated> _splittingDeleteDeactivated;
   BoolOptionValue _splittingFastRestart;
   BoolOptionValue _splittingBufferedSolver;
+  UnsignedOptionValue _splittingConflictBudget;
 
   ChoiceOptionValue<Statistics> _statistics;
   BoolOptionValue _superpositionFromVariables;
@@ -23,9 +23,16 @@
  * @since 02/06/2007 Manchester, changed to new datastructures
  */
 
+#include <cstdio>
+#include <fstream>
+
 #include "Debug/Tracer.hpp"
 
+#include "Lib/Allocator.hpp"
+#include "Lib/Int.hpp"
 #include "Lib/ScopedLet.hpp"
+#include "Lib/System.hpp"
+#include "Lib/Timer.hpp"
 
 #include "Kernel/Unit.hpp"
 #include "Kernel/Clause.hpp"
@@ -87,6 +94,63 @@
 #include "SubsumptionRemover.hpp"
 
 using namespace Shell;
+
+/**
+ * Count the formulas and the clauses among @c units.
+ */
+static void countUnits(UnitList* units, unsigned& formulas, unsigned& clauses)
+{
+  CALL("countUnits");
+
+  formulas = 0;
+  clauses = 0;
+  UnitList::Iterator uit(units);
+  while (uit.hasNext()) {
+    if (uit.next()->isClause()) {
+      clauses++;
+    } else {
+      formulas++;
+    }
+  }
+}
+
+/**
+ * Escape @c str so that it can be written in a JSON string. Control
+ * characters without a short escape are written as \\u00XX.
+ */
+static vstring jsonEscape(const vstring& str)
+{
+  vstring res;
+  for (char c : str) {
+    switch (c) {
+    case '"':
+      res += "\\\"";
+      break;
+    case '\\':
+      res += "\\\\";
+      break;
+    case '\n':
+      res += "\\n";
+      break;
+    case '\r':
+      res += "\\r";
+      break;
+    case '\t':
+      res += "\\t";
+      break;
+    default:
+      if (static_cast<unsigned char>(c) < 0x20) {
+        char buf[8];
+        snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned>(c));
+        res += buf;
+      } else {
+        res += c;
+      }
+    }
+  }
+  return res;
+}
+
 #if GNUMP
 /**
  * Bound propagation preprocessing steps. Takes as argumet @c constraints the list of constraints
@@ -184,6 +248,7 @@ void Preprocess::preprocess(Problem& prb)
   if (prb.hasInterpretedOperations() || env.signature->hasTermAlgebras()){
     // Add theory axioms if needed
     if( _options.theoryAxioms() != Options::TheoryAxiomLevel::OFF){
+      Pass pass(*this, prb, "theory_axioms");
       env.statistics->phase=Statistics::INCLUDING_THEORY_AXIOMS;
       if (env.options->showPreprocessing())
         env.out() << "adding theory axioms" << std::endl;
@@ -197,6 +262,7 @@ void Preprocess::preprocess(Problem& prb)
     // If we don't have fool then these constants get in the way (a lot)
 
     if (!_options.newCNF()) {
+      Pass pass(*this, prb, "fool_elimination");
       if (env.options->showPreprocessing())
         env.out() << "FOOL elimination" << std::endl;
       TheoryAxioms(prb).applyFOOL();
@@ -206,12 +272,14 @@ void Preprocess::preprocess(Problem& prb)
 
   if (prb.hasInterpretedOperations() || env.signature->hasTermAlgebras()){
     // Normalize them e.g. replace $greater with not $lesseq
+    Pass pass(*this, prb, "interpreted_normalization");
     InterpretedNormalizer().apply(prb);
   }
 
   // Expansion of distinct groups happens before other preprocessing
   // If a distinct group is small enough it will add inequality to describe it
   if(env.signature->hasDistinctGroups()){
+    Pass pass(*this, prb, "distinct_group_expansion");
     if(env.options->showPreprocessing())
       env.out() << "distinct group expansion" << std::endl;
     DistinctGroupExpansion().apply(prb);
@@ -219,6 +287,7 @@ void Preprocess::preprocess(Problem& prb)
 
   // reorder units
   if (_options.normalize()) {
+    Pass pass(*this, prb, "normalization");
     env.statistics->phase=Statistics::NORMALIZATION;
     if (env.options->showPreprocessing())
       env.out() << "normalization" << std::endl;
@@ -227,14 +296,19 @@ void Preprocess::preprocess(Problem& prb)
   }
 
   if (_options.sineSelection()!=Options::SineSelection::OFF) {
+    Pass pass(*this, prb, "sine_selection");
     env.statistics->phase=Statistics::SINE_SELECTION;
     if (env.options->showPreprocessing())
       env.out() << "sine selection" << std::endl;
 
-    SineSelector(_options).perform(prb);
+    //the theory axioms of the problem may have been indexed in advance
+    if (!prb.sineTheorySelector() || !prb.sineTheorySelector()->perform(prb,_options)) {
+      SineSelector(_options).perform(prb);
+    }
   }
 
   if (_options.questionAnswering()==Options::QuestionAnsweringMode::ANSWER_LITERAL) {
+    Pass pass(*this, prb, "answer_literal_addition");
     env.statistics->phase=Statistics::UNKNOWN_PHASE;
     if (env.options->showPreprocessing())
       env.out() << "answer literal addition" << std::endl;
@@ -244,10 +318,12 @@ void Preprocess::preprocess(Problem& prb)
 
   // stop here if clausification is not required
   if (!_clausify) {
+    outputReport(true);
     return;
   }
 
   if (prb.mayHaveFormulas()) {
+    Pass pass(*this, prb, "preprocess1");
     if (env.options->showPreprocessing())
       env.out() << "preprocess1 (rectify, simplify false true, flatten)" << std::endl;
 
@@ -261,6 +337,7 @@ void Preprocess::preprocess(Problem& prb)
   // - unused definitions
   // I think TrivialPredicateRemoval just removes pures
   if (_options.unusedPredicateDefinitionRemoval()) {
+    Pass pass(*this, prb, "unused_predicate_definition_removal");
     env.statistics->phase=Statistics::UNUSED_PREDICATE_DEFINITION_REMOVAL;
     if (env.options->showPreprocessing())
       env.out() << "unused predicate definition removal" << std::endl;
@@ -270,6 +347,7 @@ void Preprocess::preprocess(Problem& prb)
   }
 
   if (prb.mayHaveFormulas()) {
+    Pass pass(*this, prb, "preprocess2");
     if (env.options->showPreprocessing())
       env.out() << "preprocess 2 (ennf,flatten)" << std::endl;
 
@@ -277,12 +355,14 @@ void Preprocess::preprocess(Problem& prb)
   }
 
   if (prb.mayHaveFormulas() && _options.newCNF()) {
+    Pass pass(*this, prb, "new_cnf");
     if (env.options->showPreprocessing())
       env.out() << "newCnf" << std::endl;
 
     newCnf(prb);
   } else {
     if (prb.mayHaveFormulas() && _options.naming()) {
+      Pass pass(*this, prb, "naming");
       if (env.options->showPreprocessing())
         env.out() << "naming" << std::endl;
 
@@ -290,6 +370,7 @@ void Preprocess::preprocess(Problem& prb)
     }
 
     if (prb.mayHaveFormulas()) {
+      Pass pass(*this, prb, "preprocess3");
       if (env.options->showPreprocessing())
         env.out() << "preprocess3 (nnf, flatten, skolemize)" << std::endl;
 
@@ -297,6 +378,7 @@ void Preprocess::preprocess(Problem& prb)
     }
 
     if (prb.mayHaveFormulas()) {
+      Pass pass(*this, prb, "clausification");
       if (env.options->showPreprocessing())
         env.out() << "clausify" << std::endl;
 
@@ -305,6 +387,7 @@ void Preprocess::preprocess(Problem& prb)
   }
 
   if (prb.mayHaveFunctionDefinitions()) {
+    Pass pass(*this, prb, "function_definition_elimination");
     env.statistics->phase=Statistics::FUNCTION_DEFINITION_ELIMINATION;
     if (env.options->showPreprocessing())
       env.out() << "function definition elimination" << std::endl;
@@ -320,6 +403,7 @@ void Preprocess::preprocess(Problem& prb)
 
 
   if (prb.mayHaveEquality() && _options.inequalitySplitting() != 0) {
+    Pass pass(*this, prb, "inequality_splitting");
     if (env.options->showPreprocessing())
       env.out() << "inequality splitting" << std::endl;
 
@@ -348,6 +432,7 @@ void Preprocess::preprocess(Problem& prb)
 
    if (_options.equalityResolutionWithDeletion()!=Options::RuleActivity::OFF &&
 	   prb.mayHaveInequalityResolvableWithDeletion() ) {
+     Pass pass(*this, prb, "equality_resolution_with_deletion");
      env.statistics->phase=Statistics::EQUALITY_RESOLUTION_WITH_DELETION;
      if (env.options->showPreprocessing())
       env.out() << "equality resolution with deletion" << std::endl;
@@ -367,6 +452,7 @@ void Preprocess::preprocess(Problem& prb)
    }
 */
    if (_options.generalSplitting()!=Options::RuleActivity::OFF) {
+     Pass pass(*this, prb, "general_splitting");
      env.statistics->phase=Statistics::GENERAL_SPLITTING;
      if (env.options->showPreprocessing())
        env.out() << "general splitting" << std::endl;
@@ -376,6 +462,7 @@ void Preprocess::preprocess(Problem& prb)
    }
 
    if (_options.equalityProxy()!=Options::EqualityProxy::OFF && prb.mayHaveEquality()) {
+     Pass pass(*this, prb, "equality_proxy");
      env.statistics->phase=Statistics::EQUALITY_PROXY;
      if (env.options->showPreprocessing())
        env.out() << "equality proxy" << std::endl;
@@ -385,6 +472,7 @@ void Preprocess::preprocess(Problem& prb)
    }
 
    if(_options.theoryFlattening()){
+     Pass pass(*this, prb, "theory_flattening");
      if(env.options->showPreprocessing())
        env.out() << "theory flattening" << std::endl;
 
@@ -393,6 +481,7 @@ void Preprocess::preprocess(Problem& prb)
    }
 
    if (_options.blockedClauseElimination()) {
+     Pass pass(*this, prb, "blocked_clause_elimination");
      env.statistics->phase=Statistics::BLOCKED_CLAUSE_ELIMINATION;
      if(env.options->showPreprocessing())
        env.out() << "blocked clause elimination" << std::endl;
@@ -417,8 +506,103 @@ void Preprocess::preprocess(Problem& prb)
      env.out() << "preprocessing finished" << std::endl;
      env.endOutput();
    }
+
+   outputReport(true);
 } // Preprocess::preprocess ()
 
+/**
+ * Start measuring a preprocessing pass called @c name, if the
+ * preprocessing report is enabled.
+ */
+Preprocess::Pass::Pass(Preprocess& pp, Problem& prb, const char* name)
+: _pp(pp), _prb(prb)
+{
+  CALL("Preprocess::Pass::Pass");
+
+  if (_pp._reportFile.empty()) {
+    return;
+  }
+  _record.name = name;
+  countUnits(_prb.units(), _record.formulasIn, _record.clausesIn);
+  _record.memoryIn = Allocator::getUsedMemory();
+  Timer::syncClock();
+  _start = env.timer->elapsedMilliseconds();
+}
+
+/**
+ * Record the measured pass and update the report, so that it is
+ * available also when the preprocessing does not finish.
+ */
+Preprocess::Pass::~Pass()
+{
+  CALL("Preprocess::Pass::~Pass");
+
+  if (_pp._reportFile.empty()) {
+    return;
+  }
+  Timer::syncClock();
+  _record.time = env.timer->elapsedMilliseconds() - _start;
+  _record.memoryOut = Allocator::getUsedMemory();
+  countUnits(_prb.units(), _record.formulasOut, _record.clausesOut);
+  _pp._passes.push(_record);
+  _pp.outputReport(false);
+}
+
+/**
+ * Return the name of the file for the preprocessing report, or the empty
+ * string if no report is required. The portfolio modes may preprocess in
+ * several processes, so there each process writes into its own file.
+ */
+vstring Preprocess::reportFileName(const Options& options)
+{
+  CALL("Preprocess::reportFileName");
+
+  vstring res = options.preprocessingReport();
+  if (res.empty()) {
+    return res;
+  }
+  switch (options.mode()) {
+  case Options::Mode::CASC:
+  case Options::Mode::CASC_SAT:
+  case Options::Mode::CASC_LTB:
+  case Options::Mode::SMTCOMP:
+  case Options::Mode::PORTFOLIO:
+    return res + "." + Int::toString(System::getPID());
+  default:
+    return res;
+  }
+}
+
+/**
+ * Write the passes recorded so far as JSON into the file given by
+ * the preprocessing_report option. @c complete is false if the
+ * preprocessing has not finished yet.
+ */
+void Preprocess::outputReport(bool complete)
+{
+  CALL("Preprocess::outputReport");
+
+  if (_reportFile.empty()) {
+    return;
+  }
+
+  BYPASSING_ALLOCATOR; // for ofstream
+  ofstream out(_reportFile.c_str());
+  out << "{" << endl;
+  out << "  \"problem\": \"" << jsonEscape(_options.problemName()) << "\"," << endl;
+  out << "  \"complete\": " << (complete ? "true" : "false") << "," << endl;
+  out << "  \"passes\": [";
+  for (unsigned i = 0; i < _passes.size(); i++) {
+    const PassRecord& r = _passes[i];
+    out << (i ? "," : "") << endl;
+    out << "    {\"name\": \"" << r.name << "\", \"time_ms\": " << r.time
+        << ", \"formulas_in\": " << r.formulasIn << ", \"clauses_in\": " << r.clausesIn
+        << ", \"formulas_out\": " << r.formulasOut << ", \"clauses_out\": " << r.clausesOut
+        << ", \"memory_in\": " << r.memoryIn << ", \"memory_out\": " << r.memoryOut << "}";
+  }
+  out << endl << "  ]" << endl << "}" << endl;
+}
+
 
 /**
  * Preprocess the unit using options from opt. Preprocessing may
@@ -28,6 +28,8 @@
 #include "Kernel/Unit.hpp"
 #include "Forwards.hpp"
 
+#include "Lib/Stack.hpp"
+
 namespace Shell {
 
 using namespace Kernel;
@@ -47,7 +49,8 @@ public:
   /** Initialise the preprocessor */
   explicit Preprocess(const Options& options)
   : _options(options),
-    _clausify(true)
+    _clausify(true),
+    _reportFile(reportFileName(options))
   {}
   void preprocess(Problem& prb);
 #if GNUMP
@@ -66,10 +69,48 @@ private:
 
   void newCnf(Problem& prb);
 
+  /** Measurements of one preprocessing pass for the preprocessing report */
+  struct PassRecord {
+    const char* name;
+    /** time spent in the pass, in milliseconds */
+    int time;
+    unsigned formulasIn;
+    unsigned clausesIn;
+    unsigned formulasOut;
+    unsigned clausesOut;
+    /** memory used by the allocator before and after the pass */
+    size_t memoryIn;
+    size_t memoryOut;
+  };
+
+  /**
+   * Measures the preprocessing pass performed during the lifetime
+   * of the object. Does nothing unless the preprocessing_report
+   * option is set.
+   */
+  class Pass
+  {
+  public:
+    Pass(Preprocess& pp, Problem& prb, const char* name);
+    ~Pass();
+  private:
+    Preprocess& _pp;
+    Problem& _prb;
+    PassRecord _record;
+    int _start;
+  };
+
+  static vstring reportFileName(const Options& options);
+  void outputReport(bool complete);
+
   /** Options used in the normalisation */
   const Options& _options;
   /** If true, clausification is included in preprocessing */
   bool _clausify;
+  /** File for the preprocessing report, empty if there is no report */
+  vstring _reportFile;
+  /** Passes performed so far, only recorded for the preprocessing report */
+  Lib::Stack<PassRecord> _passes;
 #if GNUMP
   void unfoldEqualities(ConstraintRCList*& constraints);
 #endif
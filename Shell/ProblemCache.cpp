@@ -0,0 +1,641 @@
+/*
+ * File ProblemCache.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file ProblemCache.cpp
+ * Implements class ProblemCache.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <unistd.h>
+
+#include "Lib/Environment.hpp"
+#include "Lib/Int.hpp"
+#include "Lib/List.hpp"
+#include "Lib/Sys/MappedFile.hpp"
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/Formula.hpp"
+#include "Kernel/FormulaUnit.hpp"
+#include "Kernel/Inference.hpp"
+#include "Kernel/Signature.hpp"
+#include "Kernel/SortHelper.hpp"
+#include "Kernel/Sorts.hpp"
+#include "Kernel/Term.hpp"
+
+#include "Parse/TPTP.hpp"
+
+#include "Options.hpp"
+#include "Statistics.hpp"
+
+#include "ProblemCache.hpp"
+
+namespace Shell
+{
+
+using namespace std;
+
+/** The first word of a cache file, "VPC" followed by the format version */
+static const unsigned CACHE_MAGIC = 0x02435056;
+
+/** Number of words of the header of a cache file */
+static const unsigned HEADER_WORDS = 8;
+
+/** Flags stored in the header */
+enum {
+  FLAG_CONJECTURE = 1,
+  FLAG_AXIOM_NAMES = 2
+};
+
+/** Flags of a unit */
+enum {
+  UNIT_CLAUSE = 1,
+  UNIT_INCLUDED = 2,
+  UNIT_NAMED = 4,
+  /** the unit is a negated conjecture, its premise follows */
+  UNIT_NEGATED_CONJECTURE = 8
+};
+
+static void hashBytes(unsigned long long& hash, const unsigned char* bytes, size_t length)
+{
+  for(size_t i=0;i<length;i++) {
+    hash = (hash ^ bytes[i]) * 1099511628211ull;
+  }
+}
+
+static const unsigned long long HASH_INIT = 14695981039346656037ull;
+
+/**
+ * Create a cache for the input file @b inputFile kept in the directory
+ * @b directory
+ */
+ProblemCache::ProblemCache(const vstring& directory, const vstring& inputFile)
+: _directory(directory), _inputFile(inputFile), _inputSize(0), _inputHash(HASH_INIT),
+  _haveKey(false), _unsupported(false), _rd(0), _rdEnd(0)
+{
+  CALL("ProblemCache::ProblemCache");
+
+  Sys::MappedFile input(inputFile);
+  if(!input.isOpen()) {
+    return;
+  }
+  _inputSize = input.size();
+  hashBytes(_inputHash, reinterpret_cast<const unsigned char*>(input.data()), input.size());
+  _haveKey = true;
+}
+
+vstring ProblemCache::cacheFileName()
+{
+  CALL("ProblemCache::cacheFileName");
+
+  char buf[64];
+  snprintf(buf, sizeof(buf), "%016llx-%llx.vpc", _inputHash, _inputSize);
+  return _directory + "/" + buf;
+}
+
+/**
+ * Load the units of the input file from the cache into @b units
+ * and return true, or return false if there is no usable cache
+ */
+bool ProblemCache::load(UnitList*& units, bool& containsConjecture)
+{
+  CALL("ProblemCache::load");
+
+  if(!_haveKey) {
+    return false;
+  }
+  Sys::MappedFile file(cacheFileName());
+  if(!file.isOpen() || file.size()<HEADER_WORDS*sizeof(unsigned) || file.size()%sizeof(unsigned)) {
+    return false;
+  }
+  const unsigned* words = reinterpret_cast<const unsigned*>(file.data());
+  size_t wordCnt = file.size()/sizeof(unsigned);
+  unsigned long long payloadHash = HASH_INIT;
+  hashBytes(payloadHash, reinterpret_cast<const unsigned char*>(words+HEADER_WORDS),
+      (wordCnt-HEADER_WORDS)*sizeof(unsigned));
+  if(words[0]!=CACHE_MAGIC ||
+      words[1]!=(unsigned)_inputSize || words[2]!=(unsigned)(_inputSize>>32) ||
+      words[3]!=(unsigned)_inputHash || words[4]!=(unsigned)(_inputHash>>32) ||
+      words[5]!=(unsigned)payloadHash || words[6]!=(unsigned)(payloadHash>>32)) {
+    return false;
+  }
+  unsigned flags = words[7];
+  if(env.options->outputAxiomNames() && !(flags & FLAG_AXIOM_NAMES)) {
+    //the cache was created without the names
+    return false;
+  }
+
+  _rd = words+HEADER_WORDS;
+  _rdEnd = words+wordCnt;
+
+  //the symbols are stored in the order in which the parser added them,
+  //so they get the same numbers as when the file is parsed
+  unsigned predCnt = *_rd++;
+  _predNums.reset();
+  while(_predNums.size()<predCnt) {
+    _predNums.push(0);
+  }
+  for(unsigned i=0;i<predCnt;i++) {
+    unsigned local = *_rd++;
+    unsigned arity = *_rd++;
+    vstring name = readString();
+    _predNums[local] = env.signature->addPredicate(name, arity);
+  }
+  unsigned funCnt = *_rd++;
+  _funNums.reset();
+  while(_funNums.size()<funCnt) {
+    _funNums.push(0);
+  }
+  for(unsigned i=0;i<funCnt;i++) {
+    unsigned local = *_rd++;
+    unsigned arity = *_rd++;
+    vstring name = readString();
+    _funNums[local] = env.signature->addFunction(name, arity);
+  }
+
+  Stack<Unit*> loaded;
+  unsigned unitCnt = *_rd++;
+  for(unsigned i=0;i<unitCnt;i++) {
+    Unit* u = readUnit();
+    if(u->isClause()) {
+      env.statistics->inputClauses++;
+    }
+    else {
+      env.statistics->inputFormulas++;
+    }
+    loaded.push(u);
+  }
+  ASS_EQ(_rd,_rdEnd);
+
+  units = 0;
+  while(loaded.isNonEmpty()) {
+    UnitList::push(loaded.pop(), units);
+  }
+  containsConjecture = flags & FLAG_CONJECTURE;
+  return true;
+}
+
+/**
+ * Store the units obtained by @b parser from the input file into
+ * the cache, unless they contain something the cache does not support
+ */
+void ProblemCache::store(Parse::TPTP& parser)
+{
+  CALL("ProblemCache::store");
+
+  if(!_haveKey) {
+    return;
+  }
+  //the units of included files are not part of the key, and the effect
+  //of vampire() directives on the options and symbols is not stored
+  if(parser.usedIncludes() || parser.usedVampireDirectives()) {
+    _unsupported = true;
+    return;
+  }
+  UnitList* units = parser.units();
+  bool containsConjecture = parser.containsConjecture();
+
+  _words.reset();
+  unsigned unitCnt = 0;
+  UnitList::Iterator uit(units);
+  while(uit.hasNext() && !_unsupported) {
+    writeUnit(uit.next());
+    unitCnt++;
+  }
+  if(_unsupported) {
+    return;
+  }
+
+  //the symbols are known only after the units were written, but they
+  //have to be read first
+  Stack<unsigned> payload;
+  std::sort(_preds.begin(), _preds.end());
+  payload.push(_preds.size());
+  for(unsigned i=0;i<_preds.size();i++) {
+    Signature::Symbol* sym = env.signature->getPredicate(_preds[i]);
+    payload.push(_localPreds.get(_preds[i]));
+    payload.push(sym->arity());
+    writeString(payload, sym->name());
+  }
+  std::sort(_funs.begin(), _funs.end());
+  payload.push(_funs.size());
+  for(unsigned i=0;i<_funs.size();i++) {
+    Signature::Symbol* sym = env.signature->getFunction(_funs[i]);
+    payload.push(_localFuns.get(_funs[i]));
+    payload.push(sym->arity());
+    writeString(payload, sym->name());
+  }
+  payload.push(unitCnt);
+  payload.loadFromIterator(Stack<unsigned>::BottomFirstIterator(_words));
+
+  unsigned long long payloadHash = HASH_INIT;
+  hashBytes(payloadHash, reinterpret_cast<const unsigned char*>(payload.begin()),
+      payload.size()*sizeof(unsigned));
+
+  unsigned header[HEADER_WORDS];
+  header[0] = CACHE_MAGIC;
+  header[1] = _inputSize;
+  header[2] = _inputSize>>32;
+  header[3] = _inputHash;
+  header[4] = _inputHash>>32;
+  header[5] = payloadHash;
+  header[6] = payloadHash>>32;
+  header[7] = (containsConjecture ? FLAG_CONJECTURE : 0) |
+      (env.options->outputAxiomNames() ? FLAG_AXIOM_NAMES : 0);
+
+  //write into a temporary file first, so that a concurrently running
+  //process never sees an incomplete cache
+  vstring fname = cacheFileName();
+  vstring tmpName = fname + "." + Int::toString(getpid());
+  {
+    BYPASSING_ALLOCATOR;
+
+    ofstream out(tmpName.c_str(), ios::binary);
+    out.write(reinterpret_cast<const char*>(header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(payload.begin()), payload.size()*sizeof(unsigned));
+    if(!out) {
+      out.close();
+      remove(tmpName.c_str());
+      return;
+    }
+  }
+  rename(tmpName.c_str(), fname.c_str());
+}
+
+/**
+ * Push on @b words the length of @b str followed by its characters
+ * packed into words
+ */
+void ProblemCache::writeString(Stack<unsigned>& words, const vstring& str)
+{
+  words.push(str.size());
+  for(unsigned j=0;j<str.size();j+=sizeof(unsigned)) {
+    unsigned w = 0;
+    str.copy(reinterpret_cast<char*>(&w), sizeof(unsigned), j);
+    words.push(w);
+  }
+}
+
+vstring ProblemCache::readString()
+{
+  unsigned length = *_rd++;
+  vstring res(reinterpret_cast<const char*>(_rd), length);
+  _rd += (length+sizeof(unsigned)-1)/sizeof(unsigned);
+  return res;
+}
+
+unsigned ProblemCache::localPredicate(unsigned pred)
+{
+  CALL("ProblemCache::localPredicate");
+
+  unsigned* local;
+  if(_localPreds.getValuePtr(pred, local)) {
+    Signature::Symbol* sym = env.signature->getPredicate(pred);
+    if(sym->interpreted() || sym->label() || sym->answerPredicate() || sym->equalityProxy() ||
+	!sym->predType()->isAllDefault()) {
+      _unsupported = true;
+    }
+    *local = _preds.size();
+    _preds.push(pred);
+  }
+  return *local;
+}
+
+unsigned ProblemCache::localFunction(unsigned fun)
+{
+  CALL("ProblemCache::localFunction");
+
+  unsigned* local;
+  if(_localFuns.getValuePtr(fun, local)) {
+    Signature::Symbol* sym = env.signature->getFunction(fun);
+    if(sym->interpreted() || sym->stringConstant() || sym->numericConstant() ||
+	sym->overflownConstant() || sym->termAlgebraCons() || sym->distinctGroups() ||
+	!sym->fnType()->isAllDefault()) {
+      _unsupported = true;
+    }
+    *local = _funs.size();
+    _funs.push(fun);
+  }
+  return *local;
+}
+
+/**
+ * Write a term as a word with the variable number or the local function
+ * number, followed by the arguments.
+ */
+void ProblemCache::writeTerm(TermList t)
+{
+  CALL("ProblemCache::writeTerm");
+
+  if(t.isVar()) {
+    _words.push((t.var()<<1) | 1);
+    return;
+  }
+  Term* trm = t.term();
+  if(trm->isSpecial() || !trm->shared()) {
+    _unsupported = true;
+    return;
+  }
+  _words.push(localFunction(trm->functor())<<1);
+  for(TermList* arg=trm->args(); !arg->isEmpty(); arg=arg->next()) {
+    writeTerm(*arg);
+  }
+}
+
+TermList ProblemCache::readTerm()
+{
+  CALL("ProblemCache::readTerm");
+
+  unsigned w = *_rd++;
+  if(w & 1) {
+    return TermList(w>>1, false);
+  }
+  unsigned fun = _funNums[w>>1];
+  unsigned arity = env.signature->functionArity(fun);
+  if(arity==0) {
+    return TermList(Term::createConstant(fun));
+  }
+  for(unsigned i=0;i<arity;i++) {
+    TermList arg = readTerm();
+    _args.push(arg);
+  }
+  Term* res = Term::create(fun, arity, _args.end()-arity);
+  _args.truncate(_args.size()-arity);
+  return TermList(res);
+}
+
+/**
+ * Write a literal as the polarity, the local predicate number increased
+ * by one, or zero for an equality, and the arguments.
+ */
+void ProblemCache::writeLiteral(Literal* l)
+{
+  CALL("ProblemCache::writeLiteral");
+
+  _words.push(l->isPositive());
+  if(l->isEquality()) {
+    if(SortHelper::getEqualityArgumentSort(l)!=Sorts::SRT_DEFAULT) {
+      _unsupported = true;
+      return;
+    }
+    _words.push(0);
+  }
+  else {
+    _words.push(localPredicate(l->functor())+1);
+  }
+  for(TermList* arg=l->args(); !arg->isEmpty(); arg=arg->next()) {
+    writeTerm(*arg);
+  }
+}
+
+Literal* ProblemCache::readLiteral()
+{
+  CALL("ProblemCache::readLiteral");
+
+  bool polarity = *_rd++;
+  unsigned pred = *_rd++;
+  if(pred==0) {
+    TermList lhs = readTerm();
+    TermList rhs = readTerm();
+    return Literal::createEquality(polarity, lhs, rhs, Sorts::SRT_DEFAULT);
+  }
+  pred = _predNums[pred-1];
+  unsigned arity = env.signature->predicateArity(pred);
+  for(unsigned i=0;i<arity;i++) {
+    TermList arg = readTerm();
+    _args.push(arg);
+  }
+  Literal* res = Literal::create(pred, arity, polarity, false, _args.end()-arity);
+  _args.truncate(_args.size()-arity);
+  return res;
+}
+
+/**
+ * Write a formula as its connective followed by its arguments
+ */
+void ProblemCache::writeFormula(Formula* f)
+{
+  CALL("ProblemCache::writeFormula");
+
+  Connective con = f->connective();
+  _words.push(con);
+  switch(con) {
+  case LITERAL:
+    writeLiteral(f->literal());
+    return;
+  case AND:
+  case OR:
+    {
+      _words.push(FormulaList::length(f->args()));
+      FormulaList::Iterator fit(f->args());
+      while(fit.hasNext()) {
+	writeFormula(fit.next());
+      }
+      return;
+    }
+  case IMP:
+  case IFF:
+  case XOR:
+    writeFormula(f->left());
+    writeFormula(f->right());
+    return;
+  case NOT:
+    writeFormula(f->uarg());
+    return;
+  case FORALL:
+  case EXISTS:
+    {
+      _words.push(Formula::VarList::length(f->vars()));
+      Formula::VarList::Iterator vit(f->vars());
+      while(vit.hasNext()) {
+	_words.push(vit.next());
+      }
+      //the parser gives either no sorts or the default ones
+      _words.push(Formula::SortList::length(f->sorts()));
+      Formula::SortList::Iterator sit(f->sorts());
+      while(sit.hasNext()) {
+	if(sit.next()!=Sorts::SRT_DEFAULT) {
+	  _unsupported = true;
+	}
+      }
+      writeFormula(f->qarg());
+      return;
+    }
+  case TRUE:
+  case FALSE:
+    return;
+  default:
+    _unsupported = true;
+    return;
+  }
+}
+
+Formula* ProblemCache::readFormula()
+{
+  CALL("ProblemCache::readFormula");
+
+  Connective con = static_cast<Connective>(*_rd++);
+  switch(con) {
+  case LITERAL:
+    return new AtomicFormula(readLiteral());
+  case AND:
+  case OR:
+    {
+      unsigned cnt = *_rd++;
+      Stack<Formula*> args;
+      for(unsigned i=0;i<cnt;i++) {
+	args.push(readFormula());
+      }
+      FormulaList* argList = 0;
+      while(args.isNonEmpty()) {
+	FormulaList::push(args.pop(), argList);
+      }
+      return new JunctionFormula(con, argList);
+    }
+  case IMP:
+  case IFF:
+  case XOR:
+    {
+      Formula* left = readFormula();
+      Formula* right = readFormula();
+      return new BinaryFormula(con, left, right);
+    }
+  case NOT:
+    return new NegatedFormula(readFormula());
+  case FORALL:
+  case EXISTS:
+    {
+      unsigned varCnt = *_rd++;
+      Formula::VarList* vars = 0;
+      Formula::VarList::FIFO vfifo(vars);
+      for(unsigned i=0;i<varCnt;i++) {
+	vfifo.push(*_rd++);
+      }
+      unsigned sortCnt = *_rd++;
+      Formula::SortList* sorts = 0;
+      for(unsigned i=0;i<sortCnt;i++) {
+	Formula::SortList::push(Sorts::SRT_DEFAULT, sorts);
+      }
+      return new QuantifiedFormula(con, vars, sorts, readFormula());
+    }
+  case TRUE:
+    return Formula::trueFormula();
+  case FALSE:
+    return Formula::falseFormula();
+  default:
+    ASSERTION_VIOLATION;
+  }
+}
+
+/**
+ * Write a unit as its flags, input type, inherited color, name if it
+ * has one and the premise if it is a negated conjecture, followed by
+ * its literals or formula.
+ */
+void ProblemCache::writeUnit(Unit* u)
+{
+  CALL("ProblemCache::writeUnit");
+
+  unsigned flags = 0;
+  if(u->isClause()) {
+    flags |= UNIT_CLAUSE;
+  }
+  if(u->included()) {
+    flags |= UNIT_INCLUDED;
+  }
+  vstring name;
+  if(Parse::TPTP::findAxiomName(u, name)) {
+    flags |= UNIT_NAMED;
+  }
+  Inference::Rule rule = u->inference()->rule();
+  if(rule==Inference::NEGATED_CONJECTURE) {
+    flags |= UNIT_NEGATED_CONJECTURE;
+  }
+  else if(rule!=Inference::INPUT) {
+    _unsupported = true;
+    return;
+  }
+  _words.push(flags);
+  _words.push(u->inputType());
+  _words.push(u->inheritedColor());
+  if(flags & UNIT_NAMED) {
+    writeString(_words, name);
+  }
+  if(flags & UNIT_NEGATED_CONJECTURE) {
+    Inference::Iterator iit = u->inference()->iterator();
+    writeUnit(u->inference()->next(iit));
+  }
+
+  if(u->isClause()) {
+    Clause* cl = static_cast<Clause*>(u);
+    _words.push(cl->length());
+    for(unsigned i=0;i<cl->length();i++) {
+      writeLiteral((*cl)[i]);
+    }
+  }
+  else {
+    writeFormula(static_cast<FormulaUnit*>(u)->formula());
+  }
+}
+
+Unit* ProblemCache::readUnit()
+{
+  CALL("ProblemCache::readUnit");
+
+  unsigned flags = *_rd++;
+  Unit::InputType inputType = static_cast<Unit::InputType>(*_rd++);
+  Color inheritedColor = static_cast<Color>(*_rd++);
+  vstring name;
+  if(flags & UNIT_NAMED) {
+    name = readString();
+  }
+  Inference* inf;
+  if(flags & UNIT_NEGATED_CONJECTURE) {
+    inf = new Inference1(Inference::NEGATED_CONJECTURE, readUnit());
+  }
+  else {
+    inf = new Inference(Inference::INPUT);
+  }
+
+  Unit* res;
+  if(flags & UNIT_CLAUSE) {
+    unsigned length = *_rd++;
+    static Stack<Literal*> lits;
+    lits.reset();
+    for(unsigned i=0;i<length;i++) {
+      lits.push(readLiteral());
+    }
+    res = Clause::fromStack(lits, inputType, inf);
+  }
+  else {
+    res = new FormulaUnit(readFormula(), inf, inputType);
+  }
+  if(inheritedColor!=COLOR_INVALID) {
+    res->setInheritedColor(inheritedColor);
+  }
+  if(flags & UNIT_INCLUDED) {
+    res->markIncluded();
+  }
+  if((flags & UNIT_NAMED) && env.options->outputAxiomNames()) {
+    Parse::TPTP::assignAxiomName(res, name);
+  }
+  return res;
+}
+
+}
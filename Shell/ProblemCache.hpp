@@ -0,0 +1,116 @@
+/*
+ * File ProblemCache.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file ProblemCache.hpp
+ * Defines class ProblemCache.
+ */
+
+#ifndef __ProblemCache__
+#define __ProblemCache__
+
+#include "Forwards.hpp"
+
+#include "Lib/DHMap.hpp"
+#include "Lib/Stack.hpp"
+#include "Lib/VString.hpp"
+
+#include "Kernel/Unit.hpp"
+
+namespace Parse {
+class TPTP;
+}
+
+namespace Shell {
+
+using namespace Lib;
+using namespace Kernel;
+
+/**
+ * Binary cache of parsed TPTP files, kept as files in a directory.
+ *
+ * A cache file holds the symbols and the units obtained by parsing
+ * an input file. It is named after a hash of the content of the input
+ * file, so a changed file gets a new cache. The cache is read through
+ * a memory mapping and the units are rebuilt directly, without lexing
+ * or looking up symbols by name for every occurrence.
+ *
+ * Only the plain first-order fragment is cached: untyped uninterpreted
+ * symbols, formulas with the usual connectives and quantifiers, and
+ * clauses. For other inputs, and for inputs using include() or vampire()
+ * directives, no cache is created, so they are always parsed.
+ */
+class ProblemCache
+{
+public:
+  CLASS_NAME(ProblemCache);
+  USE_ALLOCATOR(ProblemCache);
+
+  ProblemCache(const vstring& directory, const vstring& inputFile);
+
+  bool load(UnitList*& units, bool& containsConjecture);
+  void store(Parse::TPTP& parser);
+
+private:
+  vstring cacheFileName();
+
+  static void writeString(Stack<unsigned>& words, const vstring& str);
+  void writeUnit(Unit* u);
+  void writeFormula(Formula* f);
+  void writeLiteral(Literal* l);
+  void writeTerm(TermList t);
+  unsigned localPredicate(unsigned pred);
+  unsigned localFunction(unsigned fun);
+
+  vstring readString();
+  Unit* readUnit();
+  Formula* readFormula();
+  Literal* readLiteral();
+  TermList readTerm();
+
+  vstring _directory;
+  vstring _inputFile;
+  /** Size of the input file */
+  unsigned long long _inputSize;
+  /** Hash of the content of the input file */
+  unsigned long long _inputHash;
+  /** True if the input file could be read and hashed */
+  bool _haveKey;
+
+  /** Words of the cache being written */
+  Stack<unsigned> _words;
+  /** Set when something not supported by the cache is met while writing */
+  bool _unsupported;
+  /** Local numbers of the symbols in the cache being written */
+  DHMap<unsigned,unsigned> _localPreds;
+  DHMap<unsigned,unsigned> _localFuns;
+  Stack<unsigned> _preds;
+  Stack<unsigned> _funs;
+
+  /** Words of the cache being read */
+  const unsigned* _rd;
+  /** End of the words of the cache being read */
+  const unsigned* _rdEnd;
+  /** Numbers in the signature of the symbols of the cache being read */
+  Stack<unsigned> _predNums;
+  Stack<unsigned> _funNums;
+  Stack<TermList> _args;
+};
+
+}
+
+#endif // __ProblemCache__
@@ -21,6 +21,7 @@
  * Implements class SineUtils.
  */
 
+#include <algorithm>
 #include <cmath>
 
 #include "Lib/Deque.hpp"
@@ -526,214 +527,410 @@ if(env.clausePriorities){
 // SineTheorySelector
 //////////////////////////////////////
 
-SineTheorySelector::SineTheorySelector(const Options& opt)
-: _genThreshold(opt.sineGeneralityThreshold()), _opt(opt)
+/** Marks the end of a level of the breadth-first search */
+static const unsigned LEVEL_END=UINT_MAX;
+
+/**
+ * Return true if a symbol with generality @b symGen defines a unit whose
+ * least general symbol has generality @b leastGen
+ *
+ * The result is monotone in @b leastGen, which allows to stop scanning
+ * the D-relation entries of a symbol at the first one that fails.
+ */
+bool SineTheorySelector::definedBy(unsigned symGen, unsigned leastGen, unsigned genThreshold, float tolerance)
 {
-  CALL("SineTheorySelector::SineTheorySelector");
+  if (symGen<=genThreshold || tolerance==-1.0f) {
+    return true;
+  }
+  //the same computation as in SineSelector::updateDefRelation
+  unsigned generalityLimit=static_cast<int>(leastGen*tolerance);
+  return symGen<=generalityLimit;
 }
 
-void SineTheorySelector::handlePossibleSignatureChange()
+bool SineTheorySelector::entryLess(const DEntry& e1, const DEntry& e2)
 {
-  CALL("SineTheorySelector::handlePossibleSignatureChange");
-
-  size_t symIdBound=_symExtr.getSymIdBound();
-  size_t oldSize=_def.size();
-  ASS_EQ(_gen.size(), oldSize);
-
-  if (symIdBound==oldSize) {
-    return;
-  }
-  ASS_G(symIdBound, oldSize);
+  return e1.leastGen>e2.leastGen;
+}
 
-  _gen.expand(symIdBound);
-  _def.expand(symIdBound);
-  for (size_t i=oldSize;i<symIdBound;i++) {
-    _gen[i]=0;
-    _def[i]=0;
+bool SineTheorySelector::localEntryLess(const LocalDEntry& e1, const LocalDEntry& e2)
+{
+  if (e1.sym!=e2.sym) {
+    return e1.sym<e2.sym;
   }
+  return e1.entry.leastGen>e2.entry.leastGen;
 }
 
 /**
- * Connect unit @b u with symbols it defines
+ * Preprocess the theory axioms in @b units, so that some of them can be later
+ * selected for a particular problem by the @b perform() function
+ *
+ * The structure does not depend on the SInE options, so each call to
+ * @b perform() can use different tolerance, depth and generality threshold.
  */
-void SineTheorySelector::updateDefRelation(Unit* u)
+void SineTheorySelector::initSelectionStructure(UnitList* units)
 {
-  CALL("SineTheorySelector::updateDefRelation");
-
-  SymIdIterator sit0=_symExtr.extractSymIds(u);
-
-  if (!sit0.hasNext()) {
-
-    if(env.clausePriorities){
-      env.clausePriorities->insert(u,1);
-    }
-
-    _unitsWithoutSymbols.push(u);
-    return;
-  }
-
-  static Stack<SymId> symIds;
-  symIds.reset();
-  symIds.loadFromIterator(sit0);
+  CALL("SineTheorySelector::initSelectionStructure");
 
-  Stack<SymId>::Iterator sit(symIds);
+  TimeCounter tc(TC_SINE_SELECTION);
 
-  ALWAYS(sit.hasNext());
-  unsigned leastGenVal=_gen[sit.next()];
+  initGeneralityFunction(units);
 
-  while (sit.hasNext()) {
-    SymId sym=sit.next();
-    unsigned val=_gen[sym];
-    ASS_G(val,0);
+  SymId symIdBound=_symExtr.getSymIdBound();
+  unsigned unitCnt=UnitList::length(units);
+
+  _units.ensure(unitCnt);
+  _unitSymStart.ensure(unitCnt+1);
+  _leastSym.ensure(unitCnt);
+  _leastGen.ensure(unitCnt);
+  //first only count the entries of each symbol
+  _defStart.init(symIdBound+1,0);
+  _leastSymStart.init(symIdBound+1,0);
+
+  Stack<SymId> syms;
+  unsigned idx=0;
+  UnitList::Iterator uit(units);
+  while (uit.hasNext()) {
+    Unit* u=uit.next();
+    _units[idx]=u;
+    _unitIndex.insert(u,idx);
+    _unitSymStart[idx]=syms.size();
 
-    if (val<leastGenVal) {
-      leastGenVal=val;
+    unsigned leastGen=UINT_MAX;
+    SymId leastSym=0;
+    SymIdIterator sit=_symExtr.extractSymIds(u);
+    while (sit.hasNext()) {
+      SymId sym=sit.next();
+      syms.push(sym);
+      _defStart[sym+1]++;
+      if (_gen[sym]<leastGen) {
+	leastGen=_gen[sym];
+	leastSym=sym;
+      }
     }
+    _leastSym[idx]=leastSym;
+    _leastGen[idx]=leastGen;
+    if (leastGen!=UINT_MAX) {
+      _leastSymStart[leastSym+1]++;
+    }
+    idx++;
   }
+  _unitSymStart[unitCnt]=syms.size();
+  _unitSyms.initFromArray(syms.size(), syms.begin());
 
-  unsigned generalityLimit=leastGenVal*(maxTolerance/strictTolerance);
-
-  Stack<SymId>::Iterator sit2(symIds);
-  while (sit2.hasNext()) {
-    SymId sym=sit2.next();
-    unsigned val=_gen[sym];
+  for (SymId sym=0;sym<symIdBound;sym++) {
+    _defStart[sym+1]+=_defStart[sym];
+    _leastSymStart[sym+1]+=_leastSymStart[sym];
+  }
 
-    if (val<=_genThreshold) {
-      //if a symbol fits under _genThreshold, add it into the relation
-      DEntryList::push(DEntry(strictTolerance,u),_def[sym]);
+  //now fill the entries, the units are visited backwards so that units with
+  //equal generality end up in the order of the D-relation lists of SineSelector
+  DArray<unsigned> defPos;
+  defPos.initFromArray(symIdBound, _defStart.array());
+  DArray<unsigned> leastSymPos;
+  leastSymPos.initFromArray(symIdBound, _leastSymStart.array());
+  _def.ensure(syms.size());
+  _leastSymUnits.ensure(_leastSymStart[symIdBound]);
+  for (unsigned i=unitCnt;i>0;i--) {
+    unsigned ui=i-1;
+    for (unsigned si=_unitSymStart[ui];si<_unitSymStart[ui+1];si++) {
+      _def[defPos[_unitSyms[si]]++]=DEntry(ui,_leastGen[ui]);
     }
-    else if (val<=generalityLimit) {
-      unsigned short minTolerance=(val*strictTolerance)/leastGenVal;
-      //only if the symbol is over _genThreshold; otherwise it is already added
-      DEntryList::push(DEntry(minTolerance,u),_def[sym]);
+    if (_leastGen[ui]!=UINT_MAX) {
+      _leastSymUnits[leastSymPos[_leastSym[ui]]++]=ui;
     }
   }
 
+  //entries of each symbol by decreasing generality of the least general symbol
+  for (SymId sym=0;sym<symIdBound;sym++) {
+    DEntry* first=_def.array()+_defStart[sym];
+    DEntry* last=_def.array()+_defStart[sym+1];
+    std::stable_sort(first, last, entryLess);
+  }
 }
 
 /**
- * Preprocess the theory axioms in @b units, so that some of them can be later
- * selected for a particular problem formulas by the @b addSelectedAxioms() function
+ * Perform the SInE selection on the problem @b prb, which must contain
+ * the theory axioms the structure was built for
  *
- * If the value of the sineTolerance and sineDepth options changes after the
- * preprocessing and before the call to the @b addSelectedAxioms function, the
- * modified values will be used (The preprocessing allows for selection with
- * tolerance values up to the limit implied by the value of @b maxTolerance.)
+ * Return false if the problem does not contain all the theory axioms
+ * any more, in which case nothing was done and SineSelector should be
+ * used instead.
  */
-void SineTheorySelector::initSelectionStructure(UnitList* units)
+bool SineTheorySelector::perform(Problem& prb, const Options& opt)
 {
-  CALL("SineTheorySelector::initSelectionStructure");
-
-  TimeCounter tc(TC_SINE_SELECTION);
-
-  initGeneralityFunction(units);
-
-  SymId symIdBound=_symExtr.getSymIdBound();
+  CALL("SineTheorySelector::perform/2");
 
-  //build the D-relation
-  _def.init(symIdBound,0);
-  UnitList::Iterator uit(units);
-  while (uit.hasNext()) {
-    Unit* u=uit.next();
-    updateDefRelation(u);
+  bool removedSomething;
+  if (!perform(prb.units(), opt, removedSomething)) {
+    return false;
   }
+  if (removedSomething) {
+    prb.reportIncompleteTransformation();
+  }
+  prb.invalidateByRemoval();
+  return true;
 }
 
-
-void SineTheorySelector::perform(UnitList*& units)
+/**
+ * Perform the SInE selection on @b units with the options @b opt
+ *
+ * Units that are not theory axioms are handled the way SineSelector does
+ * it, and the generality of symbols counts their occurrences as well.
+ * The theory axioms whose least general symbol became more general this
+ * way are handled like the units of the problem, all the other theory
+ * axioms use the precomputed D-relation.
+ */
+bool SineTheorySelector::perform(UnitList*& units, const Options& opt, bool& removedSomething)
 {
-  CALL("SineTheorySelector::perform");
+  CALL("SineTheorySelector::perform/3");
 
   TimeCounter tc(TC_SINE_SELECTION);
 
-  handlePossibleSignatureChange();
+  unsigned theoryCnt=_units.size();
+  DArray<bool> present(theoryCnt);
+  present.init(theoryCnt,false);
+  unsigned presentCnt=0;
+  Stack<Unit*> problemUnits;
 
   UnitList::Iterator uit(units);
   while (uit.hasNext()) {
     Unit* u=uit.next();
-    SymIdIterator sit=_symExtr.extractSymIds(u);
-    while (sit.hasNext()) {
-      SymId sid=sit.next();
-      _gen[sid]++;
+    unsigned idx;
+    if (_unitIndex.find(u,idx) && !present[idx]) {
+      present[idx]=true;
+      presentCnt++;
     }
+    else {
+      problemUnits.push(u);
+    }
+  }
+  if (presentCnt!=theoryCnt) {
+    return false;
   }
 
-  UnitList* res=0;
-  DHSet<SymId> addedSymIds;
-  DHSet<Unit*> selected;
-  Deque<Unit*> newlySelected;
+  bool onIncluded=opt.sineSelection()==Options::SineSelection::INCLUDED;
+  unsigned genThreshold=opt.sineGeneralityThreshold();
+  float tolerance=opt.sineTolerance();
+  unsigned depthLimit=opt.sineDepth();
+  ASS(tolerance>=1.0f || tolerance==-1);
 
-  bool sineOnIncluded=_opt.sineSelection()==Options::SineSelection::INCLUDED;
+  if (opt.sineSelection()==Options::SineSelection::PRIORITY) {
+    env.clausePriorities = new DHMap<const Unit*,unsigned>();
+  }
 
-  //build the D-relation and select the non-axiom formulas
+  //generality over the theory axioms and the problem units
+  SymId symIdBound=_symExtr.getSymIdBound();
+  SymId theorySymIdBound=_gen.size();
+  DArray<unsigned> gen(symIdBound);
+  for (SymId sym=0;sym<symIdBound;sym++) {
+    gen[sym]= sym<theorySymIdBound ? _gen[sym] : 0;
+  }
+  Stack<SymId> changedSyms;
+  Stack<Unit*>::BottomFirstIterator puit(problemUnits);
+  while (puit.hasNext()) {
+    SymIdIterator sit=_symExtr.extractSymIds(puit.next());
+    while (sit.hasNext()) {
+      SymId sym=sit.next();
+      if (sym<theorySymIdBound && gen[sym]==_gen[sym]) {
+	changedSyms.push(sym);
+      }
+      gen[sym]++;
+    }
+  }
+
+  //theory axioms whose least general symbol occurs in the problem may have
+  //a different least generality now, they get local D-relation entries
+  DArray<bool> local(theoryCnt);
+  local.init(theoryCnt,false);
+  Stack<unsigned> localTheoryUnits;
+  Stack<SymId>::Iterator csit(changedSyms);
+  while (csit.hasNext()) {
+    SymId sym=csit.next();
+    for (unsigned i=_leastSymStart[sym];i<_leastSymStart[sym+1];i++) {
+      unsigned ui=_leastSymUnits[i];
+      if (!local[ui]) {
+	local[ui]=true;
+	localTheoryUnits.push(ui);
+      }
+    }
+  }
+
+  unsigned unitCnt=theoryCnt+problemUnits.size();
+  DArray<bool> selected(unitCnt);
+  selected.init(unitCnt,false);
+  //position of each unit in @b units
+  DArray<unsigned> inputPos(unitCnt);
+  unsigned nextInputPos=0;
+  Stack<Unit*> selectedStack; //on this stack there are Units in the order they were selected
+  Stack<Unit*> unitsWithoutSymbols;
+  Deque<unsigned> newlySelected;
+  Stack<LocalDEntry> localDef;
+  Stack<SymId> syms;
+  unsigned numberUnitsLeftOut=0;
+
+  //build the local D-relation and select the non-axiom formulas
+  unsigned problemIdx=theoryCnt;
   UnitList::Iterator uit2(units);
   while (uit2.hasNext()) {
+    numberUnitsLeftOut++;
     Unit* u=uit2.next();
-    bool performSelection= sineOnIncluded ? u->included() : (u->inputType()==Unit::AXIOM);
-    if (performSelection) {
-      updateDefRelation(u);
+    unsigned idx;
+    if (!_unitIndex.find(u,idx)) {
+      idx=problemIdx++;
+    }
+    inputPos[idx]=nextInputPos++;
+    bool performSelection= onIncluded ? u->included() : (u->inputType()==Unit::AXIOM);
+    if (!performSelection) {
+      selected[idx]=true;
+      selectedStack.push(u);
+      newlySelected.push_back(idx);
+
+      if(env.clausePriorities && !env.clausePriorities->find(u)){
+        env.clausePriorities->insert(u,1);
+      }
+      continue;
+    }
+    if (idx<theoryCnt) {
+      if (_unitSymStart[idx]==_unitSymStart[idx+1]) {
+	if(env.clausePriorities){
+	  env.clausePriorities->insert(u,1);
+	}
+	unitsWithoutSymbols.push(u);
+	continue;
+      }
+      if (!local[idx]) {
+	continue;
+      }
+      syms.reset();
+      for (unsigned si=_unitSymStart[idx];si<_unitSymStart[idx+1];si++) {
+	syms.push(_unitSyms[si]);
+      }
     }
     else {
-      selected.insert(u);
-      newlySelected.push_back(u);
-      UnitList::push(u,res);
+      syms.reset();
+      syms.loadFromIterator(_symExtr.extractSymIds(u));
+      if (syms.isEmpty()) {
+	if(env.clausePriorities){
+	  env.clausePriorities->insert(u,1);
+	}
+	unitsWithoutSymbols.push(u);
+	continue;
+      }
+    }
+    unsigned leastGen=UINT_MAX;
+    Stack<SymId>::BottomFirstIterator sit(syms);
+    while (sit.hasNext()) {
+      leastGen=min(leastGen,gen[sit.next()]);
+    }
+    Stack<SymId>::BottomFirstIterator sit2(syms);
+    while (sit2.hasNext()) {
+      localDef.push(LocalDEntry(sit2.next(),DEntry(idx,leastGen)));
     }
   }
+  ASS_EQ(problemIdx,unitCnt);
+  std::stable_sort(localDef.begin(), localDef.end(), localEntryLess);
 
-
-  unsigned short intTolerance=static_cast<unsigned short>(ceil(_opt.sineTolerance()*10));
-
-  unsigned depthLimit=_opt.sineDepth();
   unsigned depth=0;
-  newlySelected.push_back(0);
+  newlySelected.push_back(LEVEL_END);
+
+  DArray<bool> symProcessed(symIdBound);
+  symProcessed.init(symIdBound,false);
 
   //select required axiom formulas
   while (newlySelected.isNonEmpty()) {
-    Unit* u=newlySelected.pop_front();
+    unsigned idx=newlySelected.pop_front();
 
-    if (!u) {
+    if (idx==LEVEL_END) {
       //next selected formulas will be one step further from the original formulas
       depth++;
+
       if (depthLimit && depth==depthLimit) {
 	break;
       }
       ASS(!depthLimit || depth<depthLimit);
+      env.maxClausePriority++;
 
       if (newlySelected.isNonEmpty()) {
 	//we must push another mark if we're not done yet
-	newlySelected.push_back(0);
+	newlySelected.push_back(LEVEL_END);
       }
       continue;
     }
 
-    SymIdIterator sit=_symExtr.extractSymIds(u);
+    syms.reset();
+    if (idx<theoryCnt) {
+      for (unsigned si=_unitSymStart[idx];si<_unitSymStart[idx+1];si++) {
+	syms.push(_unitSyms[si]);
+      }
+    }
+    else {
+      syms.loadFromIterator(_symExtr.extractSymIds(problemUnits[idx-theoryCnt]));
+    }
+
+    Stack<SymId>::BottomFirstIterator sit(syms);
     while (sit.hasNext()) {
       SymId sym=sit.next();
-      if (!addedSymIds.insert(sym)) {
-	//we already added units belonging to this symbol
+      if (symProcessed[sym]) {
 	continue;
       }
-      DEntryList::Iterator defUnits(_def[sym]);
-      while (defUnits.hasNext()) {
-	DEntry de=defUnits.next();
-
-	if (de.minTolerance>intTolerance || !selected.insert(de.unit)) {
+      symProcessed[sym]=true;
+      unsigned symGen=gen[sym];
+
+      static Stack<unsigned> defined;
+      defined.reset();
+      if (sym<theorySymIdBound) {
+	for (unsigned i=_defStart[sym];i<_defStart[sym+1];i++) {
+	  const DEntry& de=_def[i];
+	  if (!definedBy(symGen, de.leastGen, genThreshold, tolerance)) {
+	    break;
+	  }
+	  if (!local[de.unit]) {
+	    defined.push(de.unit);
+	  }
+	}
+      }
+      LocalDEntry* le=std::lower_bound(localDef.begin(), localDef.end(), LocalDEntry(sym,DEntry(0,UINT_MAX)), localEntryLess);
+      for (;le!=localDef.end() && le->sym==sym;le++) {
+	if (!definedBy(symGen, le->entry.leastGen, genThreshold, tolerance)) {
+	  break;
+	}
+	defined.push(le->entry.unit);
+      }
+      //the entries are ordered by generality only for the early break above,
+      //the units are selected in the order SineSelector would select them
+      std::sort(defined.begin(), defined.end(), LaterInInputFn(inputPos));
+
+      Stack<unsigned>::BottomFirstIterator dit(defined);
+      while (dit.hasNext()) {
+	unsigned didx=dit.next();
+	if (selected[didx]) {
 	  continue;
 	}
-	UnitList::push(de.unit,res);
-	newlySelected.push_back(de.unit);
+	Unit* du= didx<theoryCnt ? _units[didx] : problemUnits[didx-theoryCnt];
+	selected[didx]=true;
+	selectedStack.push(du);
+	newlySelected.push_back(didx);
+
+        // If in LTB mode we may already have added du with a priority
+        if(env.clausePriorities && !env.clausePriorities->find(du)){
+          env.clausePriorities->insert(du,env.maxClausePriority);
+        }
       }
     }
   }
 
-  UnitList::pushFromIterator(Stack<Unit*>::Iterator(_unitsWithoutSymbols), res);
+  env.statistics->sineIterations=depth;
+  env.statistics->selectedBySine=unitsWithoutSymbols.size() + selectedStack.size();
 
-  UnitList::destroy(units);
-//  units=res->reverse(); //we want to resemble the original SInE as much as possible
-  units=res;
+  numberUnitsLeftOut -= env.statistics->selectedBySine;
+  removedSomething = numberUnitsLeftOut>0;
 
-  env.statistics->sineIterations=depth;
-  env.statistics->selectedBySine=_unitsWithoutSymbols.size() + selected.size();
+  UnitList::destroy(units);
+  units=0;
+  UnitList::pushFromIterator(Stack<Unit*>::Iterator(unitsWithoutSymbols), units);
+  while (selectedStack.isNonEmpty()) {
+    UnitList::push(selectedStack.pop(), units);
+  }
 
 #if SINE_PRINT_SELECTED
   UnitList::Iterator selIt(units);
@@ -741,6 +938,8 @@ void SineTheorySelector::perform(UnitList*& units)
     cout<<'#'<<selIt.next()->toString()<<endl;
   }
 #endif
+
+  return true;
 }
 
 }
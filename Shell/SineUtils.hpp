@@ -27,6 +27,7 @@
 #include "Forwards.hpp"
 
 #include "Lib/DArray.hpp"
+#include "Lib/DHMap.hpp"
 #include "Lib/Stack.hpp"
 
 namespace Shell {
@@ -107,54 +108,95 @@ private:
  * sharing the same set of theory axioms
  *
  * First init the selection structure by @b initSelectionStructure() and
- * then select axioms for a particular problem by @b addSelectedAxioms()
+ * then select axioms for a particular problem by @b perform()
+ *
+ * The structure is built once for the theory axioms and not modified
+ * afterwards. It stores the symbols of every theory axiom and, for every
+ * symbol, the theory axioms containing it, ordered by the generality of
+ * their least general symbol. The selection for a problem then only
+ * counts the symbols of the problem units and runs the breadth-first
+ * search over these arrays, stopping the scan of a symbol at the first
+ * axiom it is too general for. The selected units are the same as the
+ * ones SineSelector would select from the theory axioms together with
+ * the problem units.
  */
 class SineTheorySelector
 : public SineBase
 {
 public:
-  SineTheorySelector(const Options& opt);
+  CLASS_NAME(SineTheorySelector);
+  USE_ALLOCATOR(SineTheorySelector);
 
   void initSelectionStructure(UnitList* units);
-  void perform(UnitList*& units);
-private:
 
-  /** The integer tolerance value is the float option value multiplied by 10 and
-   * truncated
-   *
-   * Therefore, if the @b maxTolerance member is equal to 50, the maximum supported
-   * tolerance is 5. */
-  static const unsigned short maxTolerance=50;
-  static const unsigned short strictTolerance=10;
+  bool perform(Problem& prb, const Options& opt);
+  bool perform(UnitList*& units, const Options& opt, bool& removedSomething);
+private:
+  struct DEntry
+  {
+    DEntry() {}
+    DEntry(unsigned unit, unsigned leastGen) : unit(unit), leastGen(leastGen) {}
 
-  void handlePossibleSignatureChange();
+    /** Index of the unit in @b _units, or past it for a problem unit */
+    unsigned unit;
+    /** Generality of the least general symbol of the unit */
+    unsigned leastGen;
+  };
 
-  void updateDefRelation(Unit* u);
+  struct LocalDEntry
+  {
+    LocalDEntry(SymId sym, DEntry entry) : sym(sym), entry(entry) {}
 
-  unsigned _genThreshold;
+    SymId sym;
+    DEntry entry;
+  };
 
-  struct DEntry
+  /**
+   * Orders unit indexes so that the units later in the input come first,
+   * the way SineSelector lists the units defining a symbol
+   */
+  struct LaterInInputFn
   {
-    DEntry(unsigned short minTolerance, Unit* unit) : minTolerance(minTolerance), unit(unit) {}
-
-    unsigned short minTolerance;
-    Unit* unit;
+    LaterInInputFn(const DArray<unsigned>& inputPos) : _inputPos(inputPos) {}
+    bool operator()(unsigned u1, unsigned u2) const { return _inputPos[u1]>_inputPos[u2]; }
+  private:
+    const DArray<unsigned>& _inputPos;
   };
-  typedef List<DEntry> DEntryList;
 
-  /** Stored the D-relation */
-  DArray<DEntryList*> _def;
+  static bool entryLess(const DEntry& e1, const DEntry& e2);
+  static bool localEntryLess(const LocalDEntry& e1, const LocalDEntry& e2);
+  static bool definedBy(unsigned symGen, unsigned leastGen, unsigned genThreshold, float tolerance);
+
+  /** Theory axioms */
+  DArray<Unit*> _units;
+  /** Indexes of the theory axioms in @b _units */
+  DHMap<Unit*,unsigned> _unitIndex;
 
   /**
-   * Stored formulas that don't contain any symbols
-   *
-   * These formulas are always selected.
+   * Symbols of the theory axiom with index i are stored in @b _unitSyms
+   * from position _unitSymStart[i] to _unitSymStart[i+1]
    */
-  Stack<Unit*> _unitsWithoutSymbols;
+  DArray<unsigned> _unitSymStart;
+  DArray<SymId> _unitSyms;
+  /** Least general symbol of each theory axiom and its generality */
+  DArray<SymId> _leastSym;
+  DArray<unsigned> _leastGen;
 
-  const Options& _opt;
-};
+  /**
+   * Stores the D-relation for all tolerances: entries for the symbol s
+   * are stored in @b _def from position _defStart[s] to _defStart[s+1],
+   * ordered by decreasing generality of the least general symbol
+   */
+  DArray<unsigned> _defStart;
+  DArray<DEntry> _def;
 
+  /**
+   * Theory axioms whose least general symbol is s are stored in
+   * @b _leastSymUnits from position _leastSymStart[s] to _leastSymStart[s+1]
+   */
+  DArray<unsigned> _leastSymStart;
+  DArray<unsigned> _leastSymUnits;
+};
 
 }
 
@@ -116,11 +116,15 @@ Statistics::Statistics()
     extensionalityClauses(0),
     discardedNonRedundantClauses(0),
     inferencesBlockedForOrderingAftercheck(0),
+    termComparisons(0),
+    cachedTermComparisons(0),
     smtReturnedUnknown(false),
     inferencesSkippedDueToColors(0),
     finalPassiveClauses(0),
     finalActiveClauses(0),
     finalExtensionalityClauses(0),
+    exportedSharedClauses(0),
+    importedSharedClauses(0),
     splitClauses(0),
     splitComponents(0),
     uniqueComponents(0),
@@ -132,6 +136,7 @@ Statistics::Statistics()
 
     satSplits(0),
     satSplitRefutations(0),
+    splittingPostponedModelUpdates(0),
 
     smtFallbacks(0),
 
@@ -264,6 +269,16 @@ void Statistics::print(ostream& out)
   COND_OUT("Inferences blocked due to ordering aftercheck", inferencesBlockedForOrderingAftercheck);
   SEPARATOR;
 
+  HEADING("Term ordering",termComparisons);
+  COND_OUT("Term comparisons", termComparisons);
+  COND_OUT("Cached term comparisons", cachedTermComparisons);
+  SEPARATOR;
+
+  HEADING("Clause sharing",exportedSharedClauses+importedSharedClauses);
+  COND_OUT("Exported clauses", exportedSharedClauses);
+  COND_OUT("Imported clauses", importedSharedClauses);
+  SEPARATOR;
+
 
   HEADING("Simplifying Inferences",duplicateLiterals+trivialInequalities+
       forwardSubsumptionResolution+backwardSubsumptionResolution+
@@ -332,12 +347,13 @@ void Statistics::print(ostream& out)
   COND_OUT("Disequalities generated from acyclicity",taAcyclicityGeneratedDisequalities);
 
   HEADING("AVATAR",splitClauses+splitComponents+uniqueComponents+satSplits+
-        satSplitRefutations);
+        satSplitRefutations+splittingPostponedModelUpdates);
   COND_OUT("Split clauses", splitClauses);
   COND_OUT("Split components", splitComponents);
   COND_OUT("Unique components", uniqueComponents);
   //COND_OUT("Sat splits", satSplits); // same as split clauses
   COND_OUT("Sat splitting refutations", satSplitRefutations);
+  COND_OUT("Postponed model updates", splittingPostponedModelUpdates);
   COND_OUT("SMT fallbacks",smtFallbacks);
   SEPARATOR;
 
@@ -199,6 +199,11 @@ public:
 
   unsigned inferencesBlockedForOrderingAftercheck;
 
+  /** comparisons of two non-variable terms by KBO */
+  unsigned termComparisons;
+  /** term comparisons answered from the KBO cache */
+  unsigned cachedTermComparisons;
+
   bool smtReturnedUnknown;
 
   unsigned inferencesSkippedDueToColors;
@@ -210,6 +215,11 @@ public:
   /** extensionality clauses at the end of the saturation algorithm run */
   unsigned finalExtensionalityClauses;
 
+  /** clauses published to the other strategies of the portfolio */
+  unsigned exportedSharedClauses;
+  /** clauses imported from the other strategies of the portfolio */
+  unsigned importedSharedClauses;
+
   unsigned splitClauses;
   unsigned splitComponents;
   //TODO currently not set, set it?
@@ -227,6 +237,8 @@ public:
 
   unsigned satSplits;
   unsigned satSplitRefutations;
+  /** Number of AVATAR model updates postponed after running out of the conflict budget */
+  unsigned splittingPostponedModelUpdates;
 
   unsigned smtFallbacks;
 
@@ -34,6 +34,7 @@
 #include "Lib/TimeCounter.hpp"
 #include "Lib/VString.hpp"
 #include "Lib/Timer.hpp"
+#include "Lib/Sys/MappedFile.hpp"
 
 #include "Kernel/InferenceStore.hpp"
 #include "Kernel/Problem.hpp"
@@ -51,6 +52,7 @@
 #include "LispLexer.hpp"
 #include "LispParser.hpp"
 #include "Options.hpp"
+#include "ProblemCache.hpp"
 #include "SimplifyProver.hpp"
 #include "Statistics.hpp"
 #include "TPTPPrinter.hpp"
@@ -237,7 +239,30 @@ Problem* UIHelper::getInputProblem(const Options& opts)
   break;
   case Options::InputSyntax::TPTP:
     {
-      Parse::TPTP parser(*input);
+      ScopedPtr<ProblemCache> cache;
+      if (inputFile!="" && opts.problemCache()!="") {
+        cache = new ProblemCache(opts.problemCache(),inputFile);
+        if (cache->load(units,s_haveConjecture)) {
+          break;
+        }
+      }
+      // a regular file is parsed directly from its memory mapping,
+      // the stream is used only when the file cannot be mapped
+      ScopedPtr<Lib::Sys::MappedFile> mapped;
+      if (inputFile!="") {
+        mapped = new Lib::Sys::MappedFile(inputFile);
+        if (!mapped->isOpen()) {
+          mapped = 0;
+        }
+      }
+      ScopedPtr<Parse::TPTP> parserPtr;
+      if (mapped) {
+        parserPtr = new Parse::TPTP(mapped->data(),mapped->size());
+      }
+      else {
+        parserPtr = new Parse::TPTP(*input);
+      }
+      Parse::TPTP& parser = *parserPtr;
       try{
         parser.parse();
       }
@@ -247,6 +272,9 @@ Problem* UIHelper::getInputProblem(const Options& opts)
       }
       units = parser.units();
       s_haveConjecture=parser.containsConjecture();
+      if (cache) {
+        cache->store(parser);
+      }
     }
     break;
   case Options::InputSyntax::SMTLIB:
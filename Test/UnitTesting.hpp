@@ -51,6 +51,10 @@ The following macros should be used:
 	  <dd>used to declare a function of the type void->void with the name proc.
 		Due to the test framework, there is no need to use the CALL macro in the beginning of this
 		function.</dd>
+	<dt>BENCHMARK_FUN(proc)</dt>
+	  <dd>declares a function like TEST_FUN, which is however run only if the
+		environment variable VTEST_BENCHMARKS is set. Benchmarks report timings
+		and are not part of the normal test run.</dd>
 </dl>
 
 If all works well, tests should not produce any output. If test should fail,
@@ -86,6 +90,7 @@ To execute tests do the following:
 </ul>
 */
 
+#include <stdlib.h>
 #include <string.h>
 #include <ostream>
 
@@ -139,6 +144,17 @@ struct TU_Aux_Test_Adder
   }
 };
 
+/** Registers a benchmark only if VTEST_BENCHMARKS is set */
+struct TU_Aux_Benchmark_Adder
+{
+  TU_Aux_Benchmark_Adder(TestUnit& tu, TestProc proc, const char* name)
+  {
+    if (getenv("VTEST_BENCHMARKS")) {
+      tu.addTest(proc, name);
+    }
+  }
+};
+
 class UnitTesting
 {
 private:
@@ -183,6 +199,10 @@ private:
 			Test::TU_Aux_Test_Adder UT_AUX_ADDER_NAME(UT_AUX_NAME,name,#name); \
 			void name()
 
+#define BENCHMARK_FUN(name)  void name(); \
+			Test::TU_Aux_Benchmark_Adder UT_AUX_ADDER_NAME(UT_AUX_NAME,name,#name); \
+			void name()
+
 }
 
 #endif // __RuntimeStatistics__
@@ -0,0 +1,103 @@
+/*
+ * File tProblemCache.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <unistd.h>
+
+#include "Lib/Environment.hpp"
+#include "Lib/Stack.hpp"
+#include "Lib/System.hpp"
+
+#include "Kernel/Unit.hpp"
+
+#include "Parse/TPTP.hpp"
+
+#include "Shell/Options.hpp"
+#include "Shell/ProblemCache.hpp"
+
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID problemcache
+UT_CREATE;
+
+using namespace std;
+using namespace Lib;
+using namespace Kernel;
+using namespace Shell;
+
+/**
+ * Parse @b content written into the file @b fname, store it into the
+ * cache in @b dir and return true if the cache can then be loaded
+ */
+static bool parseStoreAndLoad(const vstring& dir, const vstring& fname, const vstring& content)
+{
+  {
+    ofstream out(fname.c_str());
+    out << content;
+  }
+  {
+    ifstream in(fname.c_str());
+    Parse::TPTP parser(in);
+    parser.parse();
+    ProblemCache cache(dir, fname);
+    cache.store(parser);
+  }
+  ProblemCache cache(dir, fname);
+  UnitList* units;
+  bool containsConjecture;
+  bool res = cache.load(units, containsConjecture);
+  remove(fname.c_str());
+  return res;
+}
+
+/**
+ * Files with vampire() directives are not cached, since loading the cache
+ * would skip the changes of options and symbols the directives make.
+ */
+TEST_FUN(noCacheWithVampireDirectives)
+{
+  char dirTemplate[] = "/tmp/vpc_test_XXXXXX";
+  ASS(mkdtemp(dirTemplate));
+  vstring dir(dirTemplate);
+
+  ASS(parseStoreAndLoad(dir, dir+"/plain.p",
+      "fof(a,axiom,pc_p(pc_c)).\n"));
+
+  bool timeStatistics = env.options->timeStatistics();
+  ASS(!parseStoreAndLoad(dir, dir+"/option.p",
+      "vampire(option,time_statistics,on).\n"
+      "fof(a,axiom,pc_q(pc_d)).\n"));
+  env.options->set("time_statistics", timeStatistics ? "on" : "off");
+
+  bool colorUsed = env.colorUsed;
+  ASS(!parseStoreAndLoad(dir, dir+"/symbol.p",
+      "vampire(symbol,predicate,pc_r,1,left).\n"
+      "fof(a,axiom,pc_r(pc_e)).\n"));
+  env.colorUsed = colorUsed;
+
+  // remove the cache of plain.p together with the directory
+  Stack<vstring> files;
+  System::readDir(dir, files);
+  Stack<vstring>::Iterator fit(files);
+  while (fit.hasNext()) {
+    ALWAYS(unlink(fit.next().c_str())==0);
+  }
+  ALWAYS(rmdir(dir.c_str())==0);
+}
@@ -0,0 +1,169 @@
+/*
+ * File tRobSubstitution.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+
+#include <iostream>
+
+#include "Lib/Backtrackable.hpp"
+#include "Lib/Environment.hpp"
+#include "Lib/Int.hpp"
+#include "Lib/Random.hpp"
+#include "Lib/Stack.hpp"
+#include "Lib/Timer.hpp"
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/Inference.hpp"
+#include "Kernel/RobSubstitution.hpp"
+#include "Kernel/Signature.hpp"
+#include "Kernel/Term.hpp"
+
+#include "Indexing/TermSubstitutionTree.hpp"
+
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID robsubst
+UT_CREATE;
+
+using namespace std;
+using namespace Lib;
+using namespace Kernel;
+using namespace Indexing;
+
+static Stack<unsigned> fns;
+static unsigned pred;
+
+static void initSignature(unsigned fnCnt)
+{
+  fns.reset();
+  for(unsigned i=0;i<fnCnt;i++) {
+    fns.push(env.signature->addFunction("rs_f"+Int::toString(i),i%3));
+  }
+  pred=env.signature->addPredicate("rs_p",1);
+}
+
+static TermList randomTerm(unsigned depth, unsigned varCnt)
+{
+  if(depth==0 || Random::getInteger(4)==0) {
+    return TermList(Random::getInteger(varCnt),false);
+  }
+  unsigned fn=fns[Random::getInteger(fns.size())];
+  unsigned arity=env.signature->functionArity(fn);
+  Stack<TermList> args;
+  for(unsigned i=0;i<arity;i++) {
+    args.push(randomTerm(depth-1, varCnt));
+  }
+  return TermList(Term::create(fn,arity,args.begin()));
+}
+
+/**
+ * Check that unifiers of random terms make them equal, and that
+ * backtracking and resetting leave the substitution usable.
+ */
+TEST_FUN(unifyBacktrackReset)
+{
+  initSignature(5);
+  Random::setSeed(1);
+
+  RobSubstitution subst;
+  unsigned unified=0;
+  for(unsigned i=0;i<2000;i++) {
+    TermList t1=randomTerm(4, 4);
+    TermList t2=randomTerm(4, 4);
+
+    BacktrackData bd;
+    subst.bdRecord(bd);
+    bool res=subst.unify(t1,0,t2,1);
+    if(res) {
+      unified++;
+      ASS_EQ(subst.apply(t1,0),subst.apply(t2,1));
+    }
+    subst.bdDone();
+    bd.backtrack();
+    ASS_EQ(subst.size(),0);
+
+    // a term unifies with its own variant in a different bank
+    ASS(subst.unify(t1,0,t1,1));
+    ASS_EQ(subst.apply(t1,0),subst.apply(t1,1));
+    subst.reset();
+    ASS_EQ(subst.size(),0);
+
+    // and matches itself
+    ASS(subst.match(t2,2,t2,3));
+    subst.reset();
+  }
+  ASS_G(unified,0);
+
+  // variables with large numbers and several banks at once
+  TermList x(1000,false);
+  TermList y(3,false);
+  TermList t=randomTerm(3, 4);
+  ASS(subst.unify(x,7,t,0));
+  ASS(subst.unify(y,5,x,7));
+  ASS_EQ(subst.apply(y,5),subst.apply(t,0));
+  subst.reset();
+  ASS(subst.isUnbound(1000,7));
+}
+
+/**
+ * Report the throughput of unifier retrieval from a substitution tree,
+ * which is dominated by the bindings of the RobSubstitution.
+ * Runs only if VTEST_BENCHMARKS is set.
+ */
+BENCHMARK_FUN(unificationBenchmark)
+{
+  initSignature(20);
+  Random::setSeed(2);
+
+  TermSubstitutionTree tree;
+  for(unsigned i=0;i<5000;i++) {
+    TermList t;
+    do {
+      t=randomTerm(4, 3);
+    } while(t.isVar());
+    Literal* lit=Literal::create1(pred,true,t);
+    Stack<Literal*> lits;
+    lits.push(lit);
+    Clause* cl=Clause::fromStack(lits, Unit::AXIOM, new Inference(Inference::INPUT));
+    tree.insert(t, lit, cl);
+  }
+
+  Stack<TermList> queries;
+  for(unsigned i=0;i<2000;i++) {
+    queries.push(randomTerm(4, 3));
+  }
+
+  size_t cnt=0;
+  Timer::syncClock();
+  int start=env.timer->elapsedMilliseconds();
+  for(unsigned i=0;i<queries.size();i++) {
+    TermQueryResultIterator it=tree.getUnifications(queries[i], true);
+    while(it.hasNext()) {
+      TermQueryResult qr=it.next();
+      qr.substitution->applyToQuery(queries[i]);
+      cnt++;
+    }
+  }
+  Timer::syncClock();
+  int ms=env.timer->elapsedMilliseconds()-start;
+
+  cout << "unifiers: " << cnt << " in " << ms << " ms";
+  if(ms) {
+    cout << " (" << (cnt/ms) << " per ms)";
+  }
+  cout << endl;
+  ASS_G(cnt,0);
+}
@@ -18,6 +18,7 @@
  */
 
 #include "Lib/List.hpp"
+#include "Lib/Random.hpp"
 #include "Lib/Stack.hpp"
 #include "Lib/Environment.hpp"
 
@@ -26,7 +27,9 @@
 #include "SAT/SATInference.hpp"
 #include "SAT/SATSolver.hpp"
 #include "SAT/TWLSolver.hpp"
+#include "SAT/BufferedSolver.hpp"
 #include "SAT/MinisatInterfacing.hpp"
+#include "SAT/LingelingInterfacing.hpp"
 #include "SAT/Z3Interfacing.hpp"
 
 #include "Test/UnitTesting.hpp"
@@ -308,6 +311,10 @@ TEST_FUN(testSolvingUnderAssumptions)
   TWLSolver sTWL(*env.options,true);
   testAssumptions(sTWL);
 
+  cout << endl << "Lingeling" << endl;
+  LingelingInterfacing sLgl(*env.options,true);
+  testAssumptions(sLgl);
+
   /*cout << endl << "Z3" << endl;
   {
     SAT2FO sat2fo;
@@ -315,3 +322,175 @@ TEST_FUN(testSolvingUnderAssumptions)
     testAssumptions(sZ3);
   }*/
 }
+
+/**
+ * Add the pigeonhole problem of @b pigeons pigeons and @b holes holes,
+ * pigeon i sits in hole j iff the variable i*holes+j+1 is true.
+ */
+void addPigeonhole(SATSolver& s, unsigned pigeons, unsigned holes)
+{
+  CALL("addPigeonhole");
+
+  s.ensureVarCount(pigeons*holes+1);
+
+  SATLiteralStack lits;
+  for (unsigned i = 0; i < pigeons; i++) {
+    lits.reset();
+    for (unsigned j = 0; j < holes; j++) {
+      lits.push(SATLiteral(i*holes+j+1, true));
+    }
+    s.addClause(SATClause::fromStack(lits));
+  }
+  for (unsigned j = 0; j < holes; j++) {
+    for (unsigned i = 0; i < pigeons; i++) {
+      for (unsigned k = i+1; k < pigeons; k++) {
+        lits.reset();
+        lits.push(SATLiteral(i*holes+j+1, false));
+        lits.push(SATLiteral(k*holes+j+1, false));
+        s.addClause(SATClause::fromStack(lits));
+      }
+    }
+  }
+}
+
+/**
+ * Add @b clauses random clauses of three distinct variables out of @b vars,
+ * generated from the seed @b seed.
+ */
+void addRandom3Sat(SATSolver& s, unsigned vars, unsigned clauses, int seed)
+{
+  CALL("addRandom3Sat");
+
+  s.ensureVarCount(vars+1);
+  Random::setSeed(seed);
+
+  SATLiteralStack lits;
+  for (unsigned i = 0; i < clauses; i++) {
+    lits.reset();
+    while (lits.size() < 3) {
+      unsigned var = Random::getInteger(vars)+1;
+      bool fresh = true;
+      for (unsigned j = 0; j < lits.size(); j++) {
+        fresh &= lits[j].var() != var;
+      }
+      if (fresh) {
+        lits.push(SATLiteral(var, Random::getBit()));
+      }
+    }
+    s.addClause(SATClause::fromStack(lits));
+  }
+}
+
+/**
+ * Solve with a conflict budget that is doubled after each unfinished search,
+ * the way AVATAR does with a non-zero avatar_conflict_budget.
+ */
+SATSolver::Status solveInSlices(SATSolver& s, unsigned& unfinished)
+{
+  CALL("solveInSlices");
+
+  unsigned budget = 1;
+  unfinished = 0;
+  SATSolver::Status res;
+  while ((res = s.solve(budget)) == SATSolver::UNKNOWN) {
+    unfinished++;
+    budget *= 2;
+  }
+  return res;
+}
+
+void testResumedSolving(SATSolver& s, unsigned pigeons, unsigned holes, SATSolver::Status expected)
+{
+  CALL("testResumedSolving");
+
+  addPigeonhole(s, pigeons, holes);
+  unsigned unfinished;
+  ASS_EQ(solveInSlices(s, unfinished), expected);
+  if (expected == SATSolver::UNSATISFIABLE) {
+    // refuting the pigeonhole problem takes more than a single conflict
+    ASS_G(unfinished,0);
+  }
+}
+
+TEST_FUN(testConflictBudgetedSolving)
+{
+  {
+    MinisatInterfacing sMini(*env.options,true);
+    testResumedSolving(sMini, 6, 5, SATSolver::UNSATISFIABLE);
+  }
+  {
+    MinisatInterfacing sMini(*env.options,true);
+    testResumedSolving(sMini, 6, 6, SATSolver::SATISFIABLE);
+  }
+
+  {
+    TWLSolver sTWL(*env.options,true);
+    testResumedSolving(sTWL, 6, 5, SATSolver::UNSATISFIABLE);
+  }
+  {
+    TWLSolver sTWL(*env.options,true);
+    testResumedSolving(sTWL, 6, 6, SATSolver::SATISFIABLE);
+  }
+
+  // lingeling refutes the pigeonhole problem by its preprocessing alone,
+  // so it gets a random problem at the satisfiability threshold instead
+  {
+    MinisatInterfacing sMini(*env.options,true);
+    addRandom3Sat(sMini, 150, 639, 1);
+    SATSolver::Status expected = sMini.solve(UINT_MAX);
+
+    LingelingInterfacing sLgl(*env.options,true);
+    addRandom3Sat(sLgl, 150, 639, 1);
+    unsigned unfinished;
+    ASS_EQ(solveInSlices(sLgl, unfinished), expected);
+    ASS_G(unfinished,0);
+  }
+  {
+    LingelingInterfacing sLgl(*env.options,true);
+    testResumedSolving(sLgl, 6, 6, SATSolver::SATISFIABLE);
+  }
+
+  {
+    BufferedSolver sBuf(new TWLSolver(*env.options,true));
+    testResumedSolving(sBuf, 6, 5, SATSolver::UNSATISFIABLE);
+  }
+  {
+    BufferedSolver sBuf(new TWLSolver(*env.options,true));
+    testResumedSolving(sBuf, 6, 6, SATSolver::SATISFIABLE);
+  }
+}
+
+/**
+ * Variables of lingeling must stay usable in clauses and assumptions
+ * added after the solver has already simplified the clause set.
+ */
+TEST_FUN(testLingelingIncremental)
+{
+  LingelingInterfacing sLgl(*env.options,true);
+  SATSolverWithAssumptions& s = sLgl;
+  ensurePrepared(s);
+
+  s.addClause(getClause("AB"));
+  s.addClause(getClause("bC"));
+  s.addClause(getClause("cD"));
+  ASS_EQ(s.solve(),SATSolver::SATISFIABLE);
+
+  s.addClause(getClause("a"));
+  ASS_EQ(s.solve(),SATSolver::SATISFIABLE);
+  ASS(s.isZeroImplied(getLit('a').var()));
+  ASS(s.falseInAssignment(getLit('A')));
+  ASS(s.trueInAssignment(getLit('C')));
+
+  SATLiteralStack assumps;
+  assumps.push(getLit('X'));
+  assumps.push(getLit('c'));
+  ASS_EQ(s.solveUnderAssumptions(assumps),SATSolver::UNSATISFIABLE);
+  ASS_EQ(s.failedAssumptions().size(),1);
+  ASS_EQ(s.failedAssumptions()[0],getLit('c'));
+
+  // the assumptions are gone after the call
+  ASS_EQ(s.solve(),SATSolver::SATISFIABLE);
+
+  s.addClause(getClause("d"));
+  ASS_EQ(s.solve(),SATSolver::UNSATISFIABLE);
+}
@@ -0,0 +1,253 @@
+/*
+ * File tSimpleCongruenceClosure.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+
+#include "Lib/Environment.hpp"
+#include "Lib/Int.hpp"
+#include "Lib/Metaiterators.hpp"
+#include "Lib/Random.hpp"
+#include "Lib/Stack.hpp"
+#include "Lib/Timer.hpp"
+
+#include "Kernel/Signature.hpp"
+#include "Kernel/Sorts.hpp"
+#include "Kernel/Term.hpp"
+
+#include "DP/SimpleCongruenceClosure.hpp"
+
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID scc
+UT_CREATE;
+
+using namespace std;
+using namespace Lib;
+using namespace Kernel;
+using namespace DP;
+
+static Stack<unsigned> fns;
+static unsigned pred;
+
+static void initSignature()
+{
+  if(fns.isNonEmpty()) {
+    return;
+  }
+  for(unsigned i=0;i<4;i++) {
+    fns.push(env.signature->addFunction("scc_c"+Int::toString(i),0));
+  }
+  fns.push(env.signature->addFunction("scc_f",1));
+  fns.push(env.signature->addFunction("scc_g",2));
+  pred = env.signature->addPredicate("scc_p",1);
+}
+
+static TermList randomTerm(unsigned depth)
+{
+  unsigned fn = fns[Random::getInteger(fns.size())];
+  unsigned arity = env.signature->functionArity(fn);
+  if(depth==0 && arity>0) {
+    fn = fns[0];
+    arity = 0;
+  }
+  Stack<TermList> args;
+  for(unsigned i=0;i<arity;i++) {
+    args.push(randomTerm(depth-1));
+  }
+  return TermList(Term::create(fn,arity,args.begin()));
+}
+
+static Literal* randomLiteral()
+{
+  bool polarity = Random::getInteger(3)!=0;
+  TermList t1 = randomTerm(2);
+  if(Random::getInteger(4)==0) {
+    return Literal::create1(pred,polarity,t1);
+  }
+  TermList t2 = randomTerm(2);
+  return Literal::createEquality(polarity,t1,t2,Sorts::SRT_DEFAULT);
+}
+
+static DecisionProcedure::Status checkFromScratch(SimpleCongruenceClosure& cc, const LiteralStack& lits)
+{
+  cc.reset();
+  cc.addLiterals(pvi(LiteralStack::ConstIterator(lits)), false);
+  return cc.getStatus(false);
+}
+
+/**
+ * Push and pop levels of literals at random and check that the incremental
+ * closure agrees with one that is reset and given all the literals again,
+ * and that its unsat cores are unsatisfiable.
+ */
+TEST_FUN(incrementalAgreesWithReset)
+{
+  initSignature();
+  Random::setSeed(1);
+
+  SimpleCongruenceClosure incremental(0);
+  SimpleCongruenceClosure fromScratch(0);
+
+  LiteralStack lits;
+  Stack<unsigned> levelStarts;
+  unsigned unsatCnt = 0;
+  for(unsigned i=0;i<3000;i++) {
+    if(levelStarts.isNonEmpty() && Random::getInteger(3)==0) {
+      unsigned cnt = 1+Random::getInteger(levelStarts.size());
+      incremental.pop(cnt);
+      levelStarts.truncate(levelStarts.size()-cnt+1);
+      lits.truncate(levelStarts.pop());
+    }
+    else {
+      incremental.push();
+      levelStarts.push(lits.size());
+      unsigned cnt = 1+Random::getInteger(2);
+      for(unsigned j=0;j<cnt;j++) {
+        Literal* lit = randomLiteral();
+        incremental.addLiterals(pvi(getSingletonIterator(lit)), false);
+        lits.push(lit);
+      }
+    }
+
+    DecisionProcedure::Status status = incremental.getStatus(true);
+    ASS_EQ(status, checkFromScratch(fromScratch, lits));
+
+    if(status==DecisionProcedure::UNSATISFIABLE) {
+      unsatCnt++;
+      unsigned coreCnt = incremental.getUnsatCoreCount();
+      ASS_G(coreCnt,0);
+      for(unsigned c=0;c<coreCnt;c++) {
+        LiteralStack core;
+        incremental.getUnsatCore(core, c);
+        ASS_EQ(checkFromScratch(fromScratch, core), DecisionProcedure::UNSATISFIABLE);
+      }
+    }
+  }
+  ASS_G(unsatCnt,0);
+
+  incremental.reset();
+  ASS_EQ(incremental.getStatus(false), DecisionProcedure::SATISFIABLE);
+}
+
+static TermList constant(unsigned i)
+{
+  return TermList(Term::createConstant(fns[i]));
+}
+
+static TermList fApp(TermList arg)
+{
+  return TermList(Term::create1(fns[4],arg));
+}
+
+static void addLiteral(SimpleCongruenceClosure& cc, Literal* lit)
+{
+  cc.addLiterals(pvi(getSingletonIterator(lit)), false);
+}
+
+/**
+ * A term converted inside a level that is then popped must still take
+ * part in congruences implied by the merges below that level.
+ */
+TEST_FUN(congruenceOfTermConvertedInPoppedLevel)
+{
+  initSignature();
+
+  for(unsigned swapArgs=0;swapArgs<2;swapArgs++) {
+    TermList a = constant(swapArgs ? 1 : 0);
+    TermList b = constant(swapArgs ? 0 : 1);
+    TermList c = constant(2);
+
+    SimpleCongruenceClosure cc(0);
+    cc.push();
+    addLiteral(cc, Literal::createEquality(true,a,b,Sorts::SRT_DEFAULT));
+    cc.push();
+    addLiteral(cc, Literal::createEquality(true,fApp(a),c,Sorts::SRT_DEFAULT));
+    cc.pop(1);
+    cc.push();
+    addLiteral(cc, Literal::createEquality(false,fApp(a),fApp(b),Sorts::SRT_DEFAULT));
+    ASS_EQ(cc.getStatus(false), DecisionProcedure::UNSATISFIABLE);
+
+    // and the same once more after popping the conflict
+    cc.pop(1);
+    ASS_EQ(cc.getStatus(false), DecisionProcedure::SATISFIABLE);
+    cc.push();
+    addLiteral(cc, Literal::createEquality(false,fApp(b),fApp(a),Sorts::SRT_DEFAULT));
+    ASS_EQ(cc.getStatus(false), DecisionProcedure::UNSATISFIABLE);
+  }
+}
+
+/**
+ * Report the time of queries that each replace a few of the most
+ * recently added literals, answered by popping and pushing levels
+ * and by resetting and adding all the literals again.
+ * Runs only if VTEST_BENCHMARKS is set.
+ */
+BENCHMARK_FUN(incrementalBenchmark)
+{
+  initSignature();
+  Random::setSeed(2);
+
+  // positive equalities over many constants, so that the set stays
+  // satisfiable and the congruence classes stay small
+  Stack<TermList> consts;
+  for(unsigned i=0;i<100;i++) {
+    consts.push(TermList(Term::createConstant(env.signature->addFunction("scc_d"+Int::toString(i),0))));
+  }
+  unsigned g = env.signature->addFunction("scc_g",2);
+  LiteralStack pool;
+  for(unsigned i=0;i<20000;i++) {
+    TermList args[] = { consts[Random::getInteger(consts.size())], consts[Random::getInteger(consts.size())] };
+    TermList t1 = TermList(Term::create(g,2,args));
+    TermList t2 = consts[Random::getInteger(consts.size())];
+    pool.push(Literal::createEquality(true,t1,t2,Sorts::SRT_DEFAULT));
+  }
+
+  SimpleCongruenceClosure incremental(0);
+  SimpleCongruenceClosure fromScratch(0);
+  LiteralStack lits;
+  for(unsigned i=0;i<1000;i++) {
+    Literal* lit = pool[Random::getInteger(pool.size())];
+    incremental.push();
+    incremental.addLiterals(pvi(getSingletonIterator(lit)), false);
+    lits.push(lit);
+  }
+
+  int incrementalMs = 0;
+  int fromScratchMs = 0;
+  for(unsigned round=0;round<500;round++) {
+    unsigned replaced = 1+Random::getInteger(10);
+    Timer::syncClock();
+    int start = env.timer->elapsedMilliseconds();
+    incremental.pop(replaced);
+    lits.truncate(lits.size()-replaced);
+    for(unsigned i=0;i<replaced;i++) {
+      Literal* lit = pool[Random::getInteger(pool.size())];
+      incremental.push();
+      incremental.addLiterals(pvi(getSingletonIterator(lit)), false);
+      lits.push(lit);
+    }
+    DecisionProcedure::Status status = incremental.getStatus(false);
+    Timer::syncClock();
+    int mid = env.timer->elapsedMilliseconds();
+    DecisionProcedure::Status fromScratchStatus = checkFromScratch(fromScratch, lits);
+    Timer::syncClock();
+    ASS_EQ(status, DecisionProcedure::SATISFIABLE);
+    ASS_EQ(fromScratchStatus, DecisionProcedure::SATISFIABLE);
+    incrementalMs += mid-start;
+    fromScratchMs += env.timer->elapsedMilliseconds()-mid;
+  }
+  cout << "push/pop: " << incrementalMs << " ms, reset: " << fromScratchMs << " ms" << endl;
+}
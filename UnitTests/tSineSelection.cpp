@@ -0,0 +1,241 @@
+/*
+ * File tSineSelection.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+
+#include <iostream>
+
+#include "Lib/Environment.hpp"
+#include "Lib/Int.hpp"
+#include "Lib/List.hpp"
+#include "Lib/Random.hpp"
+#include "Lib/Stack.hpp"
+#include "Lib/Timer.hpp"
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/Inference.hpp"
+#include "Kernel/Signature.hpp"
+#include "Kernel/Term.hpp"
+
+#include "Shell/Options.hpp"
+#include "Shell/SineUtils.hpp"
+
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID sine
+UT_CREATE;
+
+using namespace std;
+using namespace Lib;
+using namespace Kernel;
+using namespace Shell;
+
+static Stack<unsigned> fns;
+static Stack<unsigned> preds;
+
+static void initSignature(unsigned fnCnt, unsigned predCnt)
+{
+  fns.reset();
+  preds.reset();
+  for(unsigned i=0;i<fnCnt;i++) {
+    fns.push(env.signature->addFunction("sine_f"+Int::toString(i),i%3));
+  }
+  for(unsigned i=0;i<predCnt;i++) {
+    preds.push(env.signature->addPredicate("sine_p"+Int::toString(i),1+i%2));
+  }
+}
+
+/**
+ * Return a random symbol from @b syms, preferring the ones at the
+ * beginning so that the symbols differ in generality
+ */
+static unsigned randomSymbol(const Stack<unsigned>& syms)
+{
+  unsigned bound=1+Random::getInteger(syms.size());
+  return syms[Random::getInteger(bound)];
+}
+
+static TermList randomTerm(unsigned depth)
+{
+  if(depth==0 || Random::getInteger(3)==0) {
+    return TermList(Random::getInteger(3),false);
+  }
+  unsigned fn=randomSymbol(fns);
+  unsigned arity=env.signature->functionArity(fn);
+  Stack<TermList> args;
+  for(unsigned i=0;i<arity;i++) {
+    args.push(randomTerm(depth-1));
+  }
+  return TermList(Term::create(fn,arity,args.begin()));
+}
+
+static Clause* randomClause(Unit::InputType inputType, bool included)
+{
+  Stack<Literal*> lits;
+  unsigned len=1+Random::getInteger(3);
+  while(lits.size()<len) {
+    unsigned pred=randomSymbol(preds);
+    unsigned arity=env.signature->predicateArity(pred);
+    Stack<TermList> args;
+    for(unsigned i=0;i<arity;i++) {
+      args.push(randomTerm(2));
+    }
+    Literal* lit=Literal::create(pred,arity,Random::getBit(),false,args.begin());
+    if(!lits.find(lit)) {
+      lits.push(lit);
+    }
+  }
+  Clause* res=Clause::fromStack(lits, inputType, new Inference(Inference::INPUT));
+  if(included) {
+    res->markIncluded();
+  }
+  return res;
+}
+
+static UnitList* randomUnits(unsigned cnt, Unit::InputType inputType, bool included)
+{
+  UnitList* res=0;
+  for(unsigned i=0;i<cnt;i++) {
+    UnitList::push(randomClause(inputType, included), res);
+  }
+  return res;
+}
+
+/**
+ * Check that SineTheorySelector selects the same units in the same order
+ * as SineSelector for a range of options and for problems adding both axioms and
+ * conjectures to the theory
+ */
+TEST_FUN(sineTheorySelection)
+{
+  initSignature(40,30);
+  Random::setSeed(1);
+
+  UnitList* theory=randomUnits(400, Unit::AXIOM, true);
+  SineTheorySelector theorySelector;
+  theorySelector.initSelectionStructure(theory);
+
+  const char* selections[]={"axioms","included"};
+  const char* tolerances[]={"1.0","1.2","2.0","5.0"};
+  const char* depths[]={"0","1","3"};
+  const char* thresholds[]={"0","5"};
+
+  for(unsigned pi=0;pi<10;pi++) {
+    UnitList* problem=UnitList::concat(randomUnits(1+Random::getInteger(2), Unit::NEGATED_CONJECTURE, false),
+	randomUnits(Random::getInteger(5), Unit::AXIOM, false));
+    problem=UnitList::concat(problem, UnitList::copy(theory));
+
+    for(unsigned si=0;si<2;si++) {
+      for(unsigned ti=0;ti<4;ti++) {
+	for(unsigned di=0;di<3;di++) {
+	  for(unsigned gi=0;gi<2;gi++) {
+	    Options opt;
+	    opt.set("sine_selection",selections[si]);
+	    opt.set("sine_tolerance",tolerances[ti]);
+	    opt.set("sine_depth",depths[di]);
+	    opt.set("sine_generality_threshold",thresholds[gi]);
+
+	    UnitList* expected=UnitList::copy(problem);
+	    SineSelector(opt).perform(expected);
+	    UnitList* selected=UnitList::copy(problem);
+	    bool removed;
+	    ALWAYS(theorySelector.perform(selected, opt, removed));
+
+	    ASS_EQ(UnitList::length(selected), UnitList::length(expected));
+	    ASS_EQ(removed, UnitList::length(selected)<UnitList::length(problem));
+	    UnitList::Iterator eit(expected);
+	    UnitList::Iterator uit(selected);
+	    while(uit.hasNext()) {
+	      ASS_EQ(uit.next(), eit.next());
+	    }
+	    UnitList::destroy(expected);
+	    UnitList::destroy(selected);
+	  }
+	}
+      }
+    }
+    UnitList::destroy(problem);
+  }
+
+  //without all the theory axioms the structure cannot be used
+  UnitList* partial=UnitList::copy(theory->tail());
+  Options opt;
+  opt.set("sine_selection","axioms");
+  bool removed;
+  ASS(!theorySelector.perform(partial, opt, removed));
+  UnitList::destroy(partial);
+}
+
+/**
+ * Report the time of repeated selection by SineSelector, which processes
+ * the theory for every problem, and by SineTheorySelector, which does it
+ * once.
+ * Runs only if VTEST_BENCHMARKS is set.
+ */
+BENCHMARK_FUN(sineTheorySelectionBenchmark)
+{
+  initSignature(2000,1000);
+  Random::setSeed(2);
+
+  const unsigned theoryCnt=20000;
+  const unsigned problemCnt=20;
+
+  UnitList* theory=randomUnits(theoryCnt, Unit::AXIOM, true);
+  Stack<UnitList*> problems;
+  for(unsigned i=0;i<problemCnt;i++) {
+    UnitList* problem=randomUnits(1, Unit::NEGATED_CONJECTURE, false);
+    problems.push(UnitList::concat(problem, UnitList::copy(theory)));
+  }
+
+  Options opt;
+  opt.set("sine_selection","axioms");
+  opt.set("sine_tolerance","1.5");
+  opt.set("sine_depth","3");
+
+  size_t selectedCnt=0;
+  Timer::syncClock();
+  int start=env.timer->elapsedMilliseconds();
+  for(unsigned i=0;i<problemCnt;i++) {
+    UnitList* units=UnitList::copy(problems[i]);
+    SineSelector(opt).perform(units);
+    selectedCnt+=UnitList::length(units);
+    UnitList::destroy(units);
+  }
+  Timer::syncClock();
+  int sineMs=env.timer->elapsedMilliseconds()-start;
+
+  start=env.timer->elapsedMilliseconds();
+  SineTheorySelector theorySelector;
+  theorySelector.initSelectionStructure(theory);
+  Timer::syncClock();
+  int initMs=env.timer->elapsedMilliseconds()-start;
+  size_t theorySelectedCnt=0;
+  for(unsigned i=0;i<problemCnt;i++) {
+    UnitList* units=UnitList::copy(problems[i]);
+    bool removed;
+    ALWAYS(theorySelector.perform(units, opt, removed));
+    theorySelectedCnt+=UnitList::length(units);
+    UnitList::destroy(units);
+  }
+  Timer::syncClock();
+  int theoryMs=env.timer->elapsedMilliseconds()-start;
+  ASS_EQ(selectedCnt, theorySelectedCnt);
+
+  cout << "theory axioms: " << theoryCnt << ", problems: " << problemCnt
+      << ", selected: " << selectedCnt << endl;
+  cout << "SineSelector:       " << sineMs << " ms" << endl;
+  cout << "SineTheorySelector: " << theoryMs << " ms (" << initMs << " ms to build)" << endl;
+}
@@ -0,0 +1,163 @@
+/*
+ * File tTPTPParsing.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <unistd.h>
+
+#include "Lib/Environment.hpp"
+#include "Lib/Int.hpp"
+#include "Lib/Timer.hpp"
+#include "Lib/Sys/MappedFile.hpp"
+
+#include "Kernel/Unit.hpp"
+
+#include "Parse/TPTP.hpp"
+
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID tptpparsing
+UT_CREATE;
+
+using namespace std;
+using namespace Lib;
+using namespace Lib::Sys;
+using namespace Kernel;
+
+/**
+ * Write into @b out a synthetic axiom file of about @b size bytes
+ */
+static void writeCorpus(ostream& out, size_t size)
+{
+  size_t written = 0;
+  for(unsigned i=0;written<size;i++) {
+    vstring n = Int::toString(i);
+    vstring ax = "fof(ax" + n + ",axiom,![X,Y]:(p" + Int::toString(i%97) + "(f(X,g" + n
+      + "),'quoted atom') => (m(i(X),Y) = m(Y,i(X)) | ~ q(X,Y,c" + Int::toString(i%13) + ")))).\n"
+      + "% a comment line\n"
+      + "cnf(cl" + n + ",axiom,p(X) | ~r(f(X,a),\"string\",123)).\n";
+    out << ax;
+    written += ax.size();
+  }
+}
+
+static unsigned countUnits(UnitList* units)
+{
+  return UnitList::length(units);
+}
+
+/**
+ * Check that a file parsed from its memory mapping gives the same units
+ * as when it is parsed from a stream, including the units of included
+ * files.
+ */
+TEST_FUN(mappedParsing)
+{
+  char dir[] = "/tmp/vtest_tptpXXXXXX";
+  ASS(mkdtemp(dir));
+  vstring main = vstring(dir)+"/main.p";
+  vstring inc = vstring(dir)+"/inc.ax";
+  {
+    ofstream out(inc.c_str());
+    writeCorpus(out, 10000);
+  }
+  {
+    ofstream out(main.c_str());
+    out << "fof(a,axiom,p).\ninclude('" << inc << "').\nfof(c,conjecture,q).\n";
+  }
+
+  ifstream in(main.c_str());
+  Parse::TPTP streamParser(in);
+  streamParser.parse();
+
+  MappedFile file(main);
+  ASS(file.isOpen());
+  Parse::TPTP mappedParser(file.data(),file.size());
+  mappedParser.parse();
+
+  ASS_EQ(countUnits(streamParser.units()),countUnits(mappedParser.units()));
+  ASS(mappedParser.containsConjecture());
+
+  remove(main.c_str());
+  remove(inc.c_str());
+  rmdir(dir);
+}
+
+/**
+ * Report the parsing throughput in MB/s when a file is read through
+ * a stream and when it is read directly from its memory mapping.
+ *
+ * The corpus is generated unless the VTEST_TPTP_PROBLEM environment
+ * variable names a file to use instead.
+ * Runs only if VTEST_BENCHMARKS is set.
+ */
+BENCHMARK_FUN(parsingBenchmark)
+{
+  vstring fname;
+  char dir[] = "/tmp/vtest_tptpXXXXXX";
+  const char* envName = getenv("VTEST_TPTP_PROBLEM");
+  if(envName) {
+    fname = envName;
+  }
+  else {
+    ASS(mkdtemp(dir));
+    fname = vstring(dir)+"/corpus.p";
+    ofstream out(fname.c_str());
+    writeCorpus(out, 2000000);
+  }
+
+  MappedFile file(fname);
+  ASS(file.isOpen());
+  double mb = file.size()/1048576.0;
+
+  Timer::syncClock();
+  int start = env.timer->elapsedMilliseconds();
+  unsigned streamUnits;
+  {
+    ifstream in(fname.c_str());
+    Parse::TPTP parser(in);
+    parser.parse();
+    streamUnits = countUnits(parser.units());
+  }
+  Timer::syncClock();
+  int streamMs = max(env.timer->elapsedMilliseconds()-start,1);
+
+  start = env.timer->elapsedMilliseconds();
+  unsigned mappedUnits;
+  {
+    Parse::TPTP parser(file.data(),file.size());
+    parser.parse();
+    mappedUnits = countUnits(parser.units());
+  }
+  Timer::syncClock();
+  int mappedMs = max(env.timer->elapsedMilliseconds()-start,1);
+
+  ASS_EQ(streamUnits,mappedUnits);
+
+  cout << "corpus: " << mb << " MB, " << mappedUnits << " units" << endl;
+  cout << "stream: " << mb*1000/streamMs << " MB/s" << endl;
+  cout << "mapped: " << mb*1000/mappedMs << " MB/s" << endl;
+
+  if(!envName) {
+    remove(fname.c_str());
+    rmdir(dir);
+  }
+}
@@ -0,0 +1,161 @@
+/*
+ * File tTermSharing.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include "Lib/Environment.hpp"
+#include "Lib/InsertOnlySet.hpp"
+#include "Lib/Set.hpp"
+#include "Lib/Stack.hpp"
+#include "Lib/Timer.hpp"
+
+#include "Kernel/Formula.hpp"
+#include "Kernel/FormulaUnit.hpp"
+#include "Kernel/SubformulaIterator.hpp"
+#include "Kernel/Term.hpp"
+#include "Kernel/TermIterators.hpp"
+
+#include "Indexing/TermSharing.hpp"
+
+#include "Parse/TPTP.hpp"
+
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID termsharing
+UT_CREATE;
+
+using namespace std;
+using namespace Lib;
+using namespace Kernel;
+using namespace Indexing;
+
+class ModHash {
+public:
+  static unsigned hash(unsigned i) { return i%1000; }
+  static bool equals(unsigned a, unsigned b) { return a==b; }
+};
+
+TEST_FUN(insertOnlySet1)
+{
+  InsertOnlySet<unsigned,ModHash> s;
+
+  for(unsigned i=0;i<100000;i++) {
+    ASS_EQ(s.insert(i),i);
+  }
+  for(unsigned i=0;i<100000;i+=3) {
+    ASS_EQ(s.insert(i),i);
+  }
+  ASS_EQ(s.size(),100000);
+
+  unsigned res;
+  ASS(s.find(99999u,res));
+  ASS_EQ(res,99999);
+  ASS(!s.find(100000u,res));
+
+  unsigned cnt=0;
+  InsertOnlySet<unsigned,ModHash>::Iterator it(s);
+  while(it.hasNext()) {
+    ASS_L(it.next(),100000);
+    cnt++;
+  }
+  ASS_EQ(cnt,100000);
+}
+
+/**
+ * Problem used by the benchmark unless the VTEST_TPTP_PROBLEM environment
+ * variable names another one
+ */
+static const char* BENCHMARK_PROBLEM =
+  "fof(a1,axiom,![X,Y,Z]:(m(m(X,Y),Z)=m(X,m(Y,Z)))).\n"
+  "fof(a2,axiom,![X]:(m(e,X)=X)).\n"
+  "fof(a3,axiom,![X]:(m(i(X),X)=e)).\n"
+  "fof(a4,axiom,![X,Y]:(m(i(m(X,Y)),m(X,i(Y)))=m(i(i(X)),m(Y,i(m(Y,X)))))).\n"
+  "fof(a5,axiom,![X,Y]:(p(m(X,i(Y)),f(g(X,Y),h(Y))) | ~q(i(m(Y,X)),g(e,X)))).\n"
+  "fof(c,conjecture,![X,Y]:(m(X,Y)=m(Y,X))).\n";
+
+template<class TermSet>
+static void insertTerms(const Stack<Term*>& terms)
+{
+  TermSet set;
+  Stack<Term*>::ConstIterator it(terms);
+  while(it.hasNext()) {
+    set.insert(it.next());
+  }
+}
+
+/**
+ * Report how many terms per second can be inserted into the hash-consing
+ * table of TermSharing and into the Set it used before. Runs only if
+ * VTEST_BENCHMARKS is set.
+ */
+BENCHMARK_FUN(termSharingBenchmark)
+{
+  UnitList* units;
+  const char* fname = getenv("VTEST_TPTP_PROBLEM");
+  if(fname) {
+    ifstream in(fname);
+    units = Parse::TPTP::parse(in);
+  }
+  else {
+    istringstream in(BENCHMARK_PROBLEM);
+    units = Parse::TPTP::parse(in);
+  }
+
+  Stack<Term*> terms;
+  UnitList::Iterator uit(units);
+  while(uit.hasNext()) {
+    FormulaUnit* fu = static_cast<FormulaUnit*>(uit.next());
+    SubformulaIterator sfit(fu->formula());
+    while(sfit.hasNext()) {
+      Formula* f = sfit.next();
+      if(f->connective()!=LITERAL) {
+        continue;
+      }
+      NonVariableIterator nvit(f->literal());
+      while(nvit.hasNext()) {
+        terms.push(nvit.next().term());
+      }
+    }
+  }
+
+  const unsigned rounds = 2000;
+
+  Timer::syncClock();
+  int start = env.timer->elapsedMilliseconds();
+  for(unsigned i=0;i<rounds;i++) {
+    insertTerms<InsertOnlySet<Term*,TermSharing> >(terms);
+  }
+  Timer::syncClock();
+  int insertOnlyMs = max(env.timer->elapsedMilliseconds()-start,1);
+
+  start = env.timer->elapsedMilliseconds();
+  for(unsigned i=0;i<rounds;i++) {
+    insertTerms<Set<Term*,TermSharing> >(terms);
+  }
+  Timer::syncClock();
+  int setMs = max(env.timer->elapsedMilliseconds()-start,1);
+
+  size_t inserts = (size_t)terms.size()*rounds;
+  cout << "terms: " << terms.size() << ", rounds: " << rounds << endl;
+  cout << "InsertOnlySet: " << inserts*1000/insertOnlyMs << " inserts/s" << endl;
+  cout << "Set:           " << inserts*1000/setMs << " inserts/s" << endl;
+}
@@ -0,0 +1,80 @@
+/*
+ * File tTimeCounter.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+
+#include <iostream>
+
+#include "Lib/Environment.hpp"
+#include "Lib/TimeCounter.hpp"
+#include "Lib/Timer.hpp"
+
+#include "Shell/Options.hpp"
+
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID timecnt
+UT_CREATE;
+
+using namespace std;
+using namespace Lib;
+
+static void startMeasuring()
+{
+  env.options->set("time_statistics","on");
+  TimeCounter::reinitialize();
+}
+
+/**
+ * Check that blocks much shorter than a millisecond add up in the
+ * counters, and that a nested unit is not measured longer than its parent.
+ */
+TEST_FUN(shortBlocksAddUp)
+{
+  startMeasuring();
+
+  long long last = Timer::monotonicNanoseconds();
+  long long outerStart = TimeCounter::measuredNanoseconds(TC_CONDENSATION);
+  long long innerStart = TimeCounter::measuredNanoseconds(TC_FORWARD_SUBSUMPTION);
+  for(unsigned i=0;i<100000;i++) {
+    TimeCounter outer(TC_CONDENSATION);
+    TimeCounter inner(TC_FORWARD_SUBSUMPTION);
+    long long now = Timer::monotonicNanoseconds();
+    ASS_GE(now, last);
+    last = now;
+  }
+  long long outerTime = TimeCounter::measuredNanoseconds(TC_CONDENSATION)-outerStart;
+  long long innerTime = TimeCounter::measuredNanoseconds(TC_FORWARD_SUBSUMPTION)-innerStart;
+  ASS_G(innerTime, 0);
+  ASS_GE(outerTime, innerTime);
+}
+
+/**
+ * Report the cost of starting and stopping a time counter.
+ * Runs only if VTEST_BENCHMARKS is set.
+ */
+BENCHMARK_FUN(overheadBenchmark)
+{
+  startMeasuring();
+
+  const unsigned cnt = 1000000;
+  long long start = Timer::monotonicNanoseconds();
+  for(unsigned i=0;i<cnt;i++) {
+    TimeCounter tc(TC_CONDENSATION);
+  }
+  long long elapsed = Timer::monotonicNanoseconds()-start;
+  cout << "time counter start/stop: " << (elapsed/cnt) << " ns" << endl;
+}
@@ -0,0 +1,142 @@
+#!/usr/bin/python
+"""
+Runs Vampire with the preprocessing_report option on all problems
+in a directory and summarises the per-pass reports, to find out which
+preprocessing pass is expensive or blows the problem up on which inputs.
+
+Command line:
+[-t time_limit] [-n top] [-o output_file] executable problem_dir [vampire_arg ...]
+
+Problems are the files ending with .p, .tptp or .smt2 found recursively
+in problem_dir. Vampire is run in the clausify mode with the given time
+limit (default 60 seconds) unless other arguments are given.
+
+For each pass, the summary shows the number of problems it ran on, the
+total time, and the problems with the largest time, the largest growth
+of the number of units and the largest memory increase (top of them
+per pass, default 3). Problems whose preprocessing did not finish are
+listed with the last pass that did.
+
+"-o" writes all the collected reports into output_file as a JSON list.
+"""
+
+import sys
+import os
+import json
+import subprocess
+import tempfile
+
+PROBLEM_SUFFIXES = (".p", ".tptp", ".smt2")
+
+def usage():
+    sys.stderr.write(__doc__)
+    sys.exit(1)
+
+def readArgs(args):
+    opts = {"time": "60", "top": 3, "output": None}
+    while args and args[0].startswith("-"):
+        if len(args) < 2:
+            usage()
+        if args[0] == "-t":
+            opts["time"] = args[1]
+        elif args[0] == "-n":
+            opts["top"] = int(args[1])
+        elif args[0] == "-o":
+            opts["output"] = args[1]
+        else:
+            usage()
+        args = args[2:]
+    if len(args) < 2:
+        usage()
+    opts["executable"] = args[0]
+    opts["dir"] = args[1]
+    opts["vampireArgs"] = args[2:] if len(args) > 2 else ["--mode", "clausify"]
+    return opts
+
+def problemFiles(directory):
+    res = []
+    for root, dirs, files in os.walk(directory):
+        for f in files:
+            if f.endswith(PROBLEM_SUFFIXES):
+                res.append(os.path.join(root, f))
+    return sorted(res)
+
+def runProblem(opts, problem, reportFile):
+    if os.path.exists(reportFile):
+        os.remove(reportFile)
+    cmd = [opts["executable"], "-t", opts["time"], "--preprocessing_report", reportFile] + opts["vampireArgs"] + [problem]
+    with open(os.devnull, "w") as devnull:
+        subprocess.call(cmd, stdout=devnull, stderr=devnull)
+    try:
+        with open(reportFile) as f:
+            report = json.load(f)
+    except (IOError, ValueError):
+        return None
+    report["file"] = problem
+    return report
+
+def units(p, suffix):
+    return p["formulas_" + suffix] + p["clauses_" + suffix]
+
+def growth(p):
+    return float(units(p, "out")) / max(units(p, "in"), 1)
+
+def printTop(title, entries, key, fmt, top):
+    entries = sorted(entries, key=key, reverse=True)[:top]
+    print("    %s: %s" % (title, ", ".join([fmt(e) for e in entries])))
+
+def summarise(reports, top):
+    byPass = {}
+    order = []
+    for r in reports:
+        for p in r["passes"]:
+            if p["name"] not in byPass:
+                byPass[p["name"]] = []
+                order.append(p["name"])
+            byPass[p["name"]].append((r["file"], p))
+
+    for name in order:
+        entries = byPass[name]
+        total = sum([p["time_ms"] for (f, p) in entries])
+        print("%s: %d problems, %d ms in total" % (name, len(entries), total))
+        printTop("slowest", entries, lambda e: e[1]["time_ms"],
+                 lambda e: "%s (%d ms)" % (os.path.basename(e[0]), e[1]["time_ms"]), top)
+        printTop("largest growth", entries, lambda e: growth(e[1]),
+                 lambda e: "%s (%d -> %d units)" % (os.path.basename(e[0]), units(e[1], "in"), units(e[1], "out")), top)
+        printTop("largest memory increase", entries, lambda e: e[1]["memory_out"] - e[1]["memory_in"],
+                 lambda e: "%s (%d kB)" % (os.path.basename(e[0]), (e[1]["memory_out"] - e[1]["memory_in"]) // 1024), top)
+
+    unfinished = [r for r in reports if not r["complete"]]
+    if unfinished:
+        print("preprocessing not finished:")
+        for r in unfinished:
+            last = r["passes"][-1]["name"] if r["passes"] else "none"
+            print("    %s (last finished pass: %s)" % (r["file"], last))
+
+def main():
+    opts = readArgs(sys.argv[1:])
+    fd, reportFile = tempfile.mkstemp(suffix=".json")
+    os.close(fd)
+
+    reports = []
+    failed = []
+    for problem in problemFiles(opts["dir"]):
+        report = runProblem(opts, problem, reportFile)
+        if report is None:
+            failed.append(problem)
+        else:
+            reports.append(report)
+    os.remove(reportFile)
+
+    summarise(reports, opts["top"])
+    if failed:
+        print("no report produced:")
+        for problem in failed:
+            print("    " + problem)
+
+    if opts["output"]:
+        with open(opts["output"], "w") as f:
+            json.dump(reports, f, indent=2)
+
+if __name__ == "__main__":
+    main()
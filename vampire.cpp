@@ -90,6 +90,7 @@
 
 #include "SAT/MinisatInterfacing.hpp"
 #include "SAT/MinisatInterfacingNewSimp.hpp"
+#include "SAT/LingelingInterfacing.hpp"
 #include "SAT/TWLSolver.hpp"
 #include "SAT/Preprocess.hpp"
 
@@ -546,6 +547,9 @@ void satSolverMode()
     case Options::SatSolver::MINISAT:
       solver = new MinisatInterfacingNewSimp(*env.options);
       break;      
+    case Options::SatSolver::LINGELING:
+      solver = new LingelingInterfacing(*env.options);
+      break;
     default:
       ASSERTION_VIOLATION(env.options->satSolver());
   }